@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#define Uses_TEventQueue
+#include <tvision/tv.h>
+
+#include "asyncq.h"
+
+void AsyncQueue::post(const void* owner, Task task) {
+    {
+        std::lock_guard lock(mutex);
+        pending.push_back({owner, std::move(task)});
+    }
+    // Interrupt the event loop if it is sleeping in waitForEvents().
+    TEventQueue::wakeUp();
+}
+
+void AsyncQueue::cancel(const void* owner) {
+    std::lock_guard lock(mutex);
+    std::erase_if(pending, [owner](const Entry& e) { return e.owner == owner; });
+}
+
+bool AsyncQueue::hasPending() const {
+    std::lock_guard lock(mutex);
+    return !pending.empty();
+}
+
+void AsyncQueue::dispatch() {
+    // Only the tasks present on entry are run, so a task that keeps re-posting
+    // itself cannot starve the event loop. Tasks are taken one at a time and run
+    // without holding the lock: they may post new work, cancel other owners or
+    // even open a modal dialog that dispatches recursively.
+    size_t count;
+    {
+        std::lock_guard lock(mutex);
+        count = pending.size();
+    }
+    while (count-- > 0) {
+        Task task;
+        {
+            std::lock_guard lock(mutex);
+            if (pending.empty()) break;
+            task = std::move(pending.front().task);
+            pending.pop_front();
+        }
+        task();
+    }
+}
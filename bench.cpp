@@ -0,0 +1,732 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+// dn4l_bench: micro-benchmarks for the hot paths behind the file panels.
+//
+//   dn4l_bench [entries...]
+//
+// For each size (1k, 100k and 1M entries by default) a synthetic directory is
+// created in the system temp directory, measured, and removed again. Every
+// benchmark reports its rate, and those on paths that should not allocate
+// also the allocations per operation. The logging benchmarks write to
+// dn4l.log in the current directory.
+
+#include "flpanel.h"
+#include "asyncq.h"
+#include "dirread.h"
+#include "dnlogger.h"
+#include "dnprof.h"
+#include "filelist.h"
+#include "filemask.h"
+#include "filesort.h"
+#include "search.h"
+#include "selection.h"
+#include "synthtree.h"
+#include "transfer.h"
+#include "viewfile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fnmatch.h>
+#include <sys/wait.h>
+
+// Every heap allocation made by the process is counted, so that hot paths can
+// be checked for allocations.
+static std::atomic<size_t> allocationCount {0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Runs 'fn' a few times and returns the best wall time in seconds.
+template <typename F>
+double bestOf(int runs, F&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i) {
+        auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+void report(const char* name, size_t items, double seconds) {
+    std::printf("%-40s %10zu items %10.2f ms %14.0f items/s\n",
+                name, items, seconds * 1e3, items / seconds);
+}
+
+void reportAllocations(const char* name, size_t allocations, size_t operations) {
+    std::printf("%-40s %10.2f allocations per operation\n", name, double(allocations) / operations);
+}
+
+// The listing of 'dir', unsorted; with sizes and times if 'withStat'.
+FileList readListing(const std::filesystem::path& dir, bool withStat) {
+    FileList list;
+    DirectoryReader reader(dir);
+    DirEntryInfo info;
+    while (reader.next(info)) {
+        if (withStat) reader.stat(info);
+        copyMetadata(info, list.add(info.name, info.type));
+    }
+    return list;
+}
+
+// Runs what the event loop would while 'panel' loads: the batches posted by
+// its loader thread are merged in by AsyncQueue::dispatch().
+void waitForLoad(TFilePanel& panel) {
+    auto& queue = AsyncQueue::getInstance();
+    while (panel.isLoading()) {
+        queue.dispatch();
+        std::this_thread::yield();
+    }
+    queue.dispatch();
+}
+
+// The enumeration loop TFilePanel::loadDirectory used before DirectoryReader.
+size_t enumerateWithDirectoryIterator(const std::filesystem::path& dir) {
+    size_t count = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.is_directory(ec) || entry.is_regular_file(ec)) {
+            std::string name = entry.path().filename().string();
+            count += !name.empty();
+        }
+    }
+    return count;
+}
+
+size_t enumerateWithDirectoryReader(const std::filesystem::path& dir) {
+    size_t count = 0;
+    DirectoryReader reader(dir);
+    DirEntryInfo info;
+    while (reader.next(info)) {
+        count += !info.name.empty();
+    }
+    return count;
+}
+
+void benchDirectoryReader(const SyntheticTree& tree) {
+    size_t n1 = 0, n2 = 0;
+    double t1 = bestOf(3, [&] { n1 = enumerateWithDirectoryIterator(tree.path()); });
+    double t2 = bestOf(3, [&] { n2 = enumerateWithDirectoryReader(tree.path()); });
+    report("enumerate: std::filesystem", n1, t1);
+    report("enumerate: DirectoryReader", n2, t2);
+}
+
+// A headless TFilePanel loading the directory the way it does on screen: a
+// loader thread reads and sorts batches, which are merged on this thread.
+// It is never drawn, since it has no owner.
+void benchLoad(const SyntheticTree& tree) {
+    TFilePanel panel(TRect(0, 0, 40, 20));
+    waitForLoad(panel); // The current directory, which the constructor loads.
+
+    size_t allocations = 0;
+    double t = bestOf(3, [&] {
+        size_t before = allocationCount.load(std::memory_order_relaxed);
+        panel.loadDirectory(tree.path());
+        waitForLoad(panel);
+        allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    });
+    report("load: TFilePanel", tree.size(), t);
+    reportAllocations("load: TFilePanel (per entry)", allocations, tree.size());
+
+    // Switching between orders that need no metadata sorts synchronously.
+    t = bestOf(3, [&] {
+        panel.setSortMode(SortMode::Extension);
+        panel.setSortMode(SortMode::Name);
+    });
+    report("sort: TFilePanel, name <-> extension", 2 * tree.size(), t);
+}
+
+// Runs one job on 'engine' and returns its wall time in seconds.
+double runTransfer(TransferEngine& engine, TransferKind kind, const std::filesystem::path& source,
+                   const std::filesystem::path& destination) {
+    auto& queue = AsyncQueue::getInstance();
+    auto start = Clock::now();
+    engine.enqueue(kind, {source}, destination);
+    while (engine.isBusy()) {
+        queue.dispatch();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Runs a shell command and returns its wall time in seconds, or -1 if it failed.
+double runCommand(const std::string& command) {
+    auto start = Clock::now();
+    int status = std::system(command.c_str());
+    double t = std::chrono::duration<double>(Clock::now() - start).count();
+    if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::printf("%s: failed\n", command.c_str());
+        return -1;
+    }
+    return t;
+}
+
+// Copying the tree, which is many empty files: the per-file cost of
+// TransferEngine against cp -r. Larger trees are skipped, since every run
+// writes as many files again.
+void benchCopy(const SyntheticTree& tree) {
+    constexpr size_t MAX_ENTRIES = 100000;
+    if (tree.size() > MAX_ENTRIES) return;
+
+    auto target = tree.path().string() + ".copy";
+    auto clear = [&] {
+        std::error_code ec;
+        std::filesystem::remove_all(target, ec);
+        std::filesystem::create_directory(target, ec);
+    };
+    TransferEngine engine([](const auto&) {}, [](auto&) {});
+
+    double t1 = 0, t2 = 0;
+    for (int i = 0; i < 3; ++i) {
+        clear();
+        double t = runTransfer(engine, TransferKind::Copy, tree.path(), target);
+        t1 = i ? std::min(t1, t) : t;
+
+        clear();
+        t = runCommand("cp -r '" + tree.path().string() + "' '" + target + "'");
+        t2 = i ? std::min(t2, t) : t;
+        if (t2 < 0) break;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(target, ec);
+
+    report("copy: TransferEngine", tree.size(), t1);
+    if (t2 >= 0) report("copy: cp -r", tree.size(), t2);
+}
+
+// Deleting a copy of the tree: TransferEngine against rm -rf.
+void benchDelete(const SyntheticTree& tree) {
+    constexpr size_t MAX_ENTRIES = 100000;
+    if (tree.size() > MAX_ENTRIES) return;
+
+    auto target = tree.path().string() + ".delete";
+    std::string copy = "cp -r '" + tree.path().string() + "' '" + target + "'";
+    TransferEngine engine([](const auto&) {}, [](auto&) {});
+
+    double t1 = 0, t2 = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (runCommand(copy) < 0) return;
+        double t = runTransfer(engine, TransferKind::Delete, target, {});
+        t1 = i ? std::min(t1, t) : t;
+
+        if (runCommand(copy) < 0) return;
+        t = runCommand("rm -rf '" + target + "'");
+        t2 = i ? std::min(t2, t) : t;
+        if (t2 < 0) break;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(target, ec);
+
+    report("delete: TransferEngine", tree.size(), t1);
+    if (t2 >= 0) report("delete: rm -rf", tree.size(), t2);
+}
+
+// The old sort: std::filesystem::path objects compared with path::compare.
+void benchSort(const SyntheticTree& tree) {
+    FileList list = readListing(tree.path(), false);
+
+    std::vector<std::filesystem::path> paths;
+    double t1 = bestOf(3, [&] {
+        paths.clear();
+        for (const auto& e : list) paths.emplace_back(list.name(e));
+        std::ranges::sort(paths);
+    });
+    report("sort: std::filesystem::path", paths.size(), t1);
+
+    for (auto mode : {SortMode::Name, SortMode::Extension}) {
+        FileSorter sorter(mode);
+        FileList copy;
+        double t2 = bestOf(3, [&] {
+            copy = list;
+            sorter.sort(copy);
+        });
+        report(mode == SortMode::Name ? "sort: FileSorter (name)" : "sort: FileSorter (extension)", copy.size(), t2);
+    }
+
+    FileList stated = readListing(tree.path(), true);
+    for (auto mode : {SortMode::Size, SortMode::Time}) {
+        FileSorter sorter(mode);
+        FileList copy;
+        double t = bestOf(3, [&] {
+            copy = stated;
+            sorter.sort(copy);
+        });
+        report(mode == SortMode::Size ? "sort: FileSorter (size)" : "sort: FileSorter (time)", copy.size(), t);
+    }
+}
+
+// Narrowing the listing down to the entries whose names contain a string, as
+// the indexes of the matches, one pass per keystroke of a filter.
+void benchFilter(const SyntheticTree& tree) {
+    FileList list = readListing(tree.path(), false);
+    FileSorter(SortMode::Name).sort(list);
+
+    std::vector<uint32_t> matches;
+    matches.reserve(list.size());
+    for (std::string_view pattern : {"file1", ".o", "nomatch"}) {
+        size_t allocations = 0;
+        double t = bestOf(3, [&] {
+            size_t before = allocationCount.load(std::memory_order_relaxed);
+            matches.clear();
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (list.name(i).find(pattern) != std::string_view::npos) matches.push_back(uint32_t(i));
+            }
+            allocations = allocationCount.load(std::memory_order_relaxed) - before;
+        });
+        std::string name = "filter: substring \"" + std::string(pattern) + "\"";
+        report(name.c_str(), list.size(), t);
+        reportAllocations(name.c_str(), allocations, 1);
+    }
+
+    // Typing "12.cpp" into the panel's filter: every keystroke either goes
+    // through the whole listing again or, as TFilePanel does, narrows down
+    // the matches of the keystroke before.
+    static constexpr std::string_view TYPED = "12.cpp";
+    double scratch = bestOf(3, [&] {
+        for (size_t n = 1; n <= TYPED.size(); ++n) {
+            ContentMatcher matcher(TYPED.substr(0, n), false);
+            matches.clear();
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (matcher.find(list.name(i)) != std::string_view::npos) matches.push_back(uint32_t(i));
+            }
+        }
+    });
+    report("filter: typing, each key from scratch", list.size() * TYPED.size(), scratch);
+    double narrowing = bestOf(3, [&] {
+        matches.clear();
+        ContentMatcher first(TYPED.substr(0, 1), false);
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (first.find(list.name(i)) != std::string_view::npos) matches.push_back(uint32_t(i));
+        }
+        for (size_t n = 2; n <= TYPED.size(); ++n) {
+            ContentMatcher matcher(TYPED.substr(0, n), false);
+            std::erase_if(matches, [&](uint32_t i) { return matcher.find(list.name(i)) == std::string_view::npos; });
+        }
+    });
+    report("filter: typing, narrowing the matches", list.size() * TYPED.size(), narrowing);
+}
+
+
+// Applying a mask to the listing, as the panel filter does: a compiled
+// FileMask against fnmatch() with every pattern of the mask in turn.
+void benchMask(const SyntheticTree& tree) {
+    FileList list = readListing(tree.path(), false);
+    std::vector<uint32_t> matches;
+    matches.reserve(list.size());
+    std::string name;
+    for (std::string_view masks : {"*.cpp;*.h;-*.bak", "*.o", "file1*", "file?2*.c*"}) {
+        // fnmatch() wants NUL-terminated strings; copying the name is part of its cost.
+        std::vector<std::string> included, excluded;
+        for (auto part : std::views::split(masks, ';')) {
+            std::string_view pattern(part.begin(), part.end());
+            if (pattern.starts_with('-')) {
+                excluded.emplace_back(pattern.substr(1));
+            } else {
+                included.emplace_back(pattern);
+            }
+        }
+        double t1 = bestOf(3, [&] {
+            matches.clear();
+            for (size_t i = 0; i < list.size(); ++i) {
+                name = list.name(i);
+                bool match = std::ranges::any_of(included, [&](auto& p) { return fnmatch(p.c_str(), name.c_str(), FNM_CASEFOLD) == 0; })
+                          && std::ranges::none_of(excluded, [&](auto& p) { return fnmatch(p.c_str(), name.c_str(), FNM_CASEFOLD) == 0; });
+                if (match) matches.push_back(uint32_t(i));
+            }
+        });
+        size_t expected = matches.size();
+        FileMask mask(masks);
+        double t2 = bestOf(3, [&] {
+            matches.clear();
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (mask.matches(list.name(i))) matches.push_back(uint32_t(i));
+            }
+        });
+        if (matches.size() != expected) std::printf("mask: FileMask and fnmatch disagree on \"%.*s\"\n", int(masks.size()), masks.data());
+        std::string label = "mask: fnmatch \"" + std::string(masks) + "\"";
+        report(label.c_str(), list.size(), t1);
+        label = "mask: FileMask \"" + std::string(masks) + "\"";
+        report(label.c_str(), list.size(), t2);
+    }
+}
+
+// Selecting by mask, inverting and re-sorting with a selection, as Gray+,
+// Gray* and Ctrl+F3 do in a panel.
+void benchSelection(const SyntheticTree& tree) {
+    FileList list = readListing(tree.path(), true);
+    FileSorter(SortMode::Name).sort(list);
+    FileMask mask("*.cpp");
+    Selection selection;
+
+    double t = bestOf(3, [&] {
+        selection.clear();
+        selection.apply(list, Selection::Op::Select, [&](size_t i) { return mask.matches(list.name(i)); });
+    });
+    report("select: by mask \"*.cpp\"", list.size(), t);
+    t = bestOf(3, [&] {
+        selection.apply(list, Selection::Op::Invert, [&](size_t i) { return list[i].type == FileEntryType::File; });
+    });
+    report("select: invert the files", list.size(), t);
+
+    size_t count = selection.count();
+    t = bestOf(3, [&] {
+        for (SortMode mode : {SortMode::Extension, SortMode::Name}) {
+            selection.save(list);
+            FileSorter(mode).sort(list);
+            selection.restore(list);
+        }
+    });
+    report("select: re-sort, keeping the selection", 2 * list.size(), t);
+    if (selection.count() != count) std::printf("select: the selection changed when sorting\n");
+}
+
+// The row formatting TFilePanel::drawItem did before formatRow: the display
+// name was built as a std::string for every row drawn.
+void formatRowWithStrings(TDrawBuffer& b, const FileList& list, size_t index, ushort width, TColorAttr color) {
+    b.moveChar(0, ' ', color, width);
+    if (index >= list.size()) return;
+    const FileEntry& item = list[index];
+    std::string displayName(list.name(item));
+    if (item.type == FileEntryType::Directory) displayName = "[" + displayName + "]";
+    b.moveStr(0, displayName, color, width);
+}
+
+// Redraws a panel-sized window of rows, scrolling through the whole listing.
+void benchRender(const SyntheticTree& tree) {
+    static constexpr int ROWS = 40;
+    static constexpr int WIDTH = 38;
+    FileList list = readListing(tree.path(), true);
+    FileSorter(SortMode::Name).sort(list);
+
+    TDrawBuffer b;
+    PanelColors colors {0x1B, 0x30, 0x1E, 0x3E};
+    // 'formatLine(top, y)' renders line 'y' of a page starting at entry 'top'.
+    auto run = [&](const char* name, size_t pageSize, auto&& formatLine) {
+        size_t redraws = std::max<size_t>(list.size() / pageSize, 1);
+        size_t allocations = 0;
+        double t = bestOf(3, [&] {
+            size_t before = allocationCount.load(std::memory_order_relaxed);
+            for (size_t r = 0; r < redraws; ++r) {
+                for (int y = 0; y < ROWS; ++y) formatLine(r * pageSize, y);
+            }
+            allocations = allocationCount.load(std::memory_order_relaxed) - before;
+        });
+        report(name, redraws * pageSize, t);
+        reportAllocations(name, allocations, redraws);
+    };
+
+    run("render: std::string rows", ROWS, [&](size_t top, int y) {
+        formatRowWithStrings(b, list, top + y, WIDTH, colors.normal);
+    });
+    struct { const char* name; PanelView view; int columns; } views[] = {
+        {"render: TFilePanel brief, 1 column", PanelView::Brief, 1},
+        {"render: TFilePanel brief, 3 columns", PanelView::Brief, 3},
+        {"render: TFilePanel full", PanelView::Full, 1},
+    };
+    for (const auto& v : views) {
+        PanelLayout layout = PanelLayout::compute(v.view, v.columns, TPoint {WIDTH, ROWS});
+        run(v.name, size_t(ROWS) * layout.columns, [&](size_t top, int y) {
+            TFilePanel::formatLine(b, list, layout, ROWS, top, y, top, colors);
+        });
+    }
+}
+
+// The cost of Logger::log() for the caller, in bursts that fit in the queue,
+// and the sustained rate when the queue is full and callers have to wait.
+void benchLogging() {
+    static constexpr size_t BURST = 1000;
+    static constexpr size_t SUSTAINED = 1000000;
+    auto& logger = Logger::getInstance();
+
+    for (auto mode : {Logger::Mode::Sync, Logger::Mode::Async}) {
+        logger.setMode(mode);
+        double best = 1e30;
+        size_t allocations = 0;
+        for (int run = 0; run < 5; ++run) {
+            logger.flush();
+            size_t before = allocationCount.load(std::memory_order_relaxed);
+            auto start = Clock::now();
+            for (size_t i = 0; i < BURST; ++i) logger.log(LogLevel::Info, "dn4l_bench: log burst", i);
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+            allocations = allocationCount.load(std::memory_order_relaxed) - before;
+        }
+        const char* name = mode == Logger::Mode::Sync ? "log: burst, sync" : "log: burst, async";
+        report(name, BURST, best);
+        reportAllocations(name, allocations, BURST);
+    }
+
+    logger.setOverflowPolicy(Logger::OverflowPolicy::Block);
+    double t = bestOf(1, [&] {
+        for (size_t i = 0; i < SUSTAINED; ++i) logger.log(LogLevel::Info, "dn4l_bench: log sustained", i);
+        logger.flush();
+    });
+    report("log: sustained, async, blocking", SUSTAINED, t);
+    logger.setOverflowPolicy(Logger::OverflowPolicy::Drop);
+
+    // A call below the runtime level; the argument would allocate if evaluated.
+    Logger::setLevel(LogLevel::Warning);
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    t = bestOf(3, [&] {
+        for (size_t i = 0; i < SUSTAINED; ++i) DNLOG_INFO("dn4l_bench: disabled", std::to_string(i));
+    });
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    report("log: below the runtime level", SUSTAINED, t);
+    reportAllocations("log: below the runtime level", allocations, SUSTAINED);
+    Logger::setLevel(LogLevel::Debug);
+}
+
+// The overhead of a ScopedTimer, which stays compiled into the hot paths.
+void benchProfiler() {
+    static constexpr size_t SCOPES = 10000000;
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    double t = bestOf(3, [] {
+        for (size_t i = 0; i < SCOPES; ++i) {
+            ScopedTimer timer(Probe::DrawLine);
+        }
+    });
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    report("profiler: scoped timer", SCOPES, t);
+    reportAllocations("profiler: scoped timer", allocations, SCOPES);
+    Profiler::getInstance().reset();
+}
+
+// Scanning a buffer of text that doesn't contain the pattern, which is what
+// most of a content search is: ContentMatcher against std::string_view::find(),
+// and its case-insensitive mode against lowercasing every byte.
+void benchContentMatch() {
+    static constexpr size_t SIZE = 64 << 20;
+    std::string data(SIZE, ' ');
+    uint32_t seed = 1;
+    for (char& c : data) {
+        seed = seed * 1664525 + 1013904223;
+        c = "etaoinshrdlu ETAOIN\n"[(seed >> 24) % 20];
+    }
+    std::string_view pattern = "The threshold";
+    size_t found = 0;
+
+    double t = bestOf(3, [&] { found += std::string_view(data).find(pattern) != std::string_view::npos; });
+    report("content: string_view::find", SIZE, t);
+    ContentMatcher exact(pattern, true);
+    t = bestOf(3, [&] { found += exact.find(data) != std::string_view::npos; });
+    report("content: ContentMatcher", SIZE, t);
+
+    t = bestOf(3, [&] {
+        std::string_view lower = "the threshold";
+        for (size_t i = 0; i + lower.size() <= data.size(); ++i) {
+            size_t j = 0;
+            while (j < lower.size() && std::tolower((unsigned char) data[i + j]) == lower[j]) ++j;
+            if (j == lower.size()) {
+                ++found;
+                break;
+            }
+        }
+    });
+    report("content: tolower scan, ignoring case", SIZE, t);
+    ContentMatcher folded(pattern, false);
+    t = bestOf(3, [&] { found += folded.find(data) != std::string_view::npos; });
+    report("content: ContentMatcher, ignoring case", SIZE, t);
+    if (found) std::printf("content: unexpected match\n");
+}
+
+// Counting lines, and what the viewer (F3) does with a big log file. The file
+// is read back from the page cache, so this measures the scanning, not the disk.
+void benchViewer() {
+    static constexpr size_t SIZE = 256 << 20;
+    static constexpr int PAGE = 50;
+    static constexpr size_t JUMPS = 10000;
+    std::string data(SIZE, 'x');
+    uint32_t seed = 1;
+    for (char& c : data) {
+        seed = seed * 1664525 + 1013904223;
+        if ((seed >> 24) % 64 == 0) c = '\n';
+    }
+    size_t lines = 0;
+    double t = bestOf(3, [&] { lines = size_t(std::count(data.begin(), data.end(), '\n')); });
+    report("view: std::count of line feeds", SIZE, t);
+    size_t counted = 0;
+    t = bestOf(3, [&] { counted = countNewlines(data); });
+    report("view: countNewlines", SIZE, t);
+    if (counted != lines) std::printf("view: countNewlines found %zu of %zu line feeds\n", counted, lines);
+
+    auto path = std::filesystem::temp_directory_path() / "dn4l_bench_view.log";
+    if (std::FILE* f = std::fopen(path.c_str(), "wb")) {
+        std::fwrite(data.data(), 1, data.size(), f);
+        std::fclose(f);
+    }
+    auto& queue = AsyncQueue::getInstance();
+    std::string scratch;
+    // What F3 shows right away: a page from the middle, before any line is counted.
+    t = bestOf(3, [&] {
+        ViewFile file(path, [] {});
+        uint64_t offset = file.lineStart(file.size() / 2);
+        for (int y = 0; y < PAGE; ++y) file.line(offset, scratch, offset);
+    });
+    report("view: open, show a page mid-file", PAGE, t);
+    t = bestOf(3, [&] {
+        ViewFile file(path, [] {});
+        while (!file.isComplete()) {
+            queue.dispatch();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        counted = file.lineCount();
+    });
+    report("view: open and count the lines", SIZE, t);
+    size_t expected = lines + (data.back() != '\n');
+    if (counted != expected) std::printf("view: counted %zu of %zu lines\n", counted, expected);
+
+    ViewFile file(path, [] {});
+    while (!file.isComplete()) {
+        queue.dispatch();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    uint64_t sum = 0;
+    t = bestOf(3, [&] {
+        uint32_t s = 1;
+        for (size_t i = 0; i < JUMPS; ++i) {
+            s = s * 1664525 + 1013904223;
+            sum += file.lineOffset(s % lines).value_or(0);
+        }
+    });
+    report("view: go to a line", JUMPS, t);
+    queue.dispatch();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (sizes.empty()) sizes = {1000, 100000, 1000000};
+
+    for (size_t entries : sizes) {
+        std::printf("\n== %zu entries\n", entries);
+        SyntheticTree tree(entries);
+        benchDirectoryReader(tree);
+        benchLoad(tree);
+        benchSort(tree);
+        benchFilter(tree);
+        benchMask(tree);
+        benchSelection(tree);
+        benchRender(tree);
+        benchCopy(tree);
+        benchDelete(tree);
+    }
+
+    std::printf("\n== Logging and instrumentation\n");
+    benchLogging();
+    benchProfiler();
+
+    std::printf("\n== Content search\n");
+    benchContentMatch();
+
+    std::printf("\n== Viewer\n");
+    benchViewer();
+    return 0;
+}
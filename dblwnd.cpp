@@ -87,8 +87,8 @@
 TDoublePanelWindow::TDoublePanelWindow(const TRect& bounds, TStringView title, short number)
     : TWindowInit(&TDoublePanelWindow::initFrame), TWindow(bounds, title, number)
 {
-    Logger::getInstance().log("TDoublePanelWindow constructor starting...");
-    Logger::getInstance().log("Initial Bounds", bounds);
+    DNLOG_DEBUG("TDoublePanelWindow constructor starting...");
+    DNLOG_DEBUG("Initial Bounds", bounds);
 
     // Standard window flags. wfGrow allows the window to be resized.
     flags |= wfGrow;
@@ -96,7 +96,7 @@ TDoublePanelWindow::TDoublePanelWindow(const TRect& bounds, TStringView title, s
     options |= ofSelectable;
 
     TRect r = getExtent();
-    Logger::getInstance().log("Client Area (getExtent)", r);
+    DNLOG_DEBUG("Client Area (getExtent)", r);
 
     // The divider is positioned exactly in the middle.
     // Note: On odd widths, the left panel will be one column narrower.
@@ -105,19 +105,29 @@ TDoublePanelWindow::TDoublePanelWindow(const TRect& bounds, TStringView title, s
 
     // Create the left panel. Its coordinates are relative to the window's client area.
     TRect leftRect = {r.a.x + 1, r.a.y + 2, dividerX - 1, r.b.y - 2};
-    leftPanel = new TFilePanel(leftRect);
+    leftPanel = new TFilePanel(leftRect, &listingCache, &sizeCache);
     // 'insert' adds the view as a child and transfers ownership to this TWindow.
     insert(leftPanel);
 
     // Create the right panel.
     TRect rightRect = {dividerX + 2, r.a.y + 2, r.b.x - 1, r.b.y - 2};
-    rightPanel = new TFilePanel(rightRect);
+    rightPanel = new TFilePanel(rightRect, &listingCache, &sizeCache);
     insert(rightPanel);
 
     // Set the initial focus to one of the panels.
     rightPanel->select();
 
-    Logger::getInstance().log("TDoublePanelWindow constructor finished.");
+    DNLOG_DEBUG("TDoublePanelWindow constructor finished.");
+}
+
+TDoublePanelWindow::~TDoublePanelWindow() {
+    // Report how well the listing cache did, to help tuning its capacity.
+    const auto& stats = listingCache.stats();
+    DNLOG_INFO("Listing cache (hits, misses, stale, evictions, listings, bytes)",
+        stats.hits, stats.misses, stats.stale, stats.evictions, stats.listings, stats.bytes);
+    auto sizeStats = sizeCache.stats();
+    DNLOG_INFO("Size cache (hits, misses, directories, bytes)",
+        sizeStats.hits, sizeStats.misses, sizeStats.entries, sizeStats.bytes);
 }
 
 void TDoublePanelWindow::draw() {
@@ -90,6 +90,9 @@
 #define Uses_TDrawBuffer
 #include <tvision/tv.h>
 
+#include "dircache.h"
+#include "dirsize.h"
+
 class TFilePanel; // Forward-declaration
 
 class TDoublePanelWindow : public TWindow {
@@ -101,9 +104,16 @@ public:
     TFilePanel* rightPanel;
 
     TDoublePanelWindow(const TRect& bounds, TStringView title, short number);
+    ~TDoublePanelWindow();
 
     void draw() override;
     void handleEvent(TEvent& event) override;
+
+private:
+    // Listings of recently visited directories, shared by both panels.
+    DirectoryCache listingCache;
+    // Sizes of the directories read for the size column, shared too.
+    DirSizeCache sizeCache;
 };
 
 #endif // DBLWND_H
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DIRCACHE_H
+#define DIRCACHE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "filelist.h"
+#include "filesort.h"
+
+// A memory-bounded LRU cache of sorted directory listings, shared by the two
+// panels of a TDoublePanelWindow so that going back and forth between large
+// directories doesn't pay for the enumeration and sort every time.
+//
+// A listing is stored together with the modification time the directory had
+// before it was read; creating, deleting or renaming an entry changes that
+// time and turns the cached listing into a miss. The caller supplies the times,
+// so the cache itself never touches the file system. Only the names, types
+// and order are kept: rewriting a file leaves the directory's time alone, so
+// sizes and times are left for the panel to read again.
+class DirectoryCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;     // Including stale listings.
+        size_t stale = 0;      // Found, but the directory changed since.
+        size_t evictions = 0;
+        size_t bytes = 0;      // Current memory usage of the stored listings.
+        size_t listings = 0;
+    };
+
+    explicit DirectoryCache(size_t capacityBytes = DEFAULT_CAPACITY) : capacity(capacityBytes) {}
+
+    using Time = std::filesystem::file_time_type;
+
+    // Stores a copy of the complete listing of 'dir', sorted by 'mode'.
+    // 'mtime' is the directory's modification time from before it was read.
+    void put(const std::filesystem::path& dir, const FileList& list, SortMode mode, Time mtime);
+
+    // If a listing of 'dir' is cached and 'mtime', the directory's current
+    // modification time, shows it hasn't changed since, copies it to 'list',
+    // sets 'mode' to the order it is sorted in and returns true.
+    bool get(const std::filesystem::path& dir, Time mtime, FileList& list, SortMode& mode);
+
+    void invalidate(const std::filesystem::path& dir);
+
+    const Stats& stats() const { return counters; }
+
+private:
+    struct Listing {
+        std::string key;
+        FileList list;
+        SortMode mode;
+        Time mtime;
+        size_t bytes;
+    };
+    using LruList = std::list<Listing>; // Most recently used first.
+
+    void erase(LruList::iterator it);
+    void evict();
+
+    size_t capacity;
+    LruList lru;
+    std::unordered_map<std::string, LruList::iterator> index;
+    Stats counters;
+};
+
+#endif // DIRCACHE_H
@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "dirload.h"
+#include "dirread.h"
+#include "asyncq.h"
+#include "dnprof.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// The first batch is kept small so that the panel can show the first screenful
+// immediately; subsequent batch sizes double up to the maximum.
+constexpr size_t FIRST_BATCH_SIZE = 256;
+constexpr size_t MAX_BATCH_SIZE = 16384;
+// On slow file systems a partial batch is flushed after this long anyway.
+constexpr auto BATCH_INTERVAL = std::chrono::milliseconds(100);
+
+}
+
+DirectoryLoader::~DirectoryLoader() {
+    for (auto& w : workers) {
+        w.thread.request_stop();
+    }
+    workers.clear(); // std::jthread joins on destruction.
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void DirectoryLoader::start(const std::filesystem::path& dir, FileSorter sorter, BatchHandler aOnBatch, FinishHandler aOnFinish) {
+    cancel();
+    reapWorkers();
+
+    onBatch = std::move(aOnBatch);
+    onFinish = std::move(aOnFinish);
+    running = true;
+
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    workers.push_back({std::jthread(&DirectoryLoader::scan, dir, sorter, this, generation, done), done});
+}
+
+void DirectoryLoader::cancel() {
+    ++generation;
+    running = false;
+    // The worker is not joined here: it may be blocked in a slow readdir() on a
+    // network mount. It will notice the stop request and be reaped later.
+    for (auto& w : workers) {
+        w.thread.request_stop();
+    }
+}
+
+void DirectoryLoader::reapWorkers() {
+    std::erase_if(workers, [](const Worker& w) { return w.done->load(); });
+}
+
+void DirectoryLoader::scan(std::stop_token stop, std::filesystem::path dir, FileSorter sorter,
+                           DirectoryLoader* self, unsigned generation, std::shared_ptr<std::atomic<bool>> done) {
+    auto& queue = AsyncQueue::getInstance();
+    // Only the UI thread may touch 'self'; the worker merely uses it as a token.
+    auto postBatch = [&](Batch&& batch) {
+        {
+            ScopedTimer timer(Probe::SortBatch);
+            sorter.sort(batch);
+        }
+        queue.post(self, [self, generation, batch = std::move(batch)]() mutable {
+            if (self->generation == generation) self->onBatch(batch);
+        });
+    };
+
+    Batch batch;
+    size_t batchSize = FIRST_BATCH_SIZE;
+    auto lastFlush = std::chrono::steady_clock::now();
+    auto batchStart = lastFlush; // For the Enumerate probe; excludes posting.
+
+    DirectoryReader reader(dir);
+    DirEntryInfo info;
+    while (!stop.stop_requested() && reader.next(info)) {
+        copyMetadata(info, batch.add(info.name, info.type));
+
+        auto now = std::chrono::steady_clock::now();
+        if (batch.size() >= batchSize || now - lastFlush >= BATCH_INTERVAL) {
+            Profiler::getInstance().record(Probe::Enumerate, uint64_t(std::chrono::nanoseconds(now - batchStart).count()));
+            postBatch(std::move(batch));
+            batch = {};
+            batchSize = std::min(batchSize * 2, MAX_BATCH_SIZE);
+            lastFlush = now;
+            batchStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    if (!stop.stop_requested()) {
+        if (!batch.empty()) {
+            Profiler::getInstance().record(Probe::Enumerate, uint64_t(std::chrono::nanoseconds(std::chrono::steady_clock::now() - batchStart).count()));
+            postBatch(std::move(batch));
+        }
+        queue.post(self, [self, generation, ec = reader.error()] {
+            if (self->generation == generation) {
+                self->running = false;
+                self->onFinish(ec);
+            }
+        });
+    }
+    done->store(true);
+}
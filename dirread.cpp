@@ -0,0 +1,354 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "dirread.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cerrno>
+#include <cstddef>
+
+namespace {
+
+// getdents64() returns as many records as fit, so a large buffer means few
+// system calls: 256 KiB holds roughly 8000 typical entries.
+constexpr size_t READ_BUFFER_SIZE = 256 * 1024;
+
+// The kernel's record layout for getdents64(); glibc doesn't always expose it.
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+bool isDotOrDotDot(const char* name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+}
+
+DirectoryReader::DirectoryReader(const std::filesystem::path& dir) {
+    dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        ec.assign(errno, std::generic_category());
+        return;
+    }
+    buffer.resize(READ_BUFFER_SIZE);
+}
+
+DirectoryReader::DirectoryReader(int parentFd, const char* name) {
+    dirFd = ::openat(parentFd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (dirFd < 0) {
+        ec.assign(errno, std::generic_category());
+        return;
+    }
+    buffer.resize(READ_BUFFER_SIZE);
+}
+
+DirectoryReader::~DirectoryReader() {
+    if (dirFd >= 0) ::close(dirFd);
+}
+
+int DirectoryReader::release() {
+    int fd = dirFd;
+    dirFd = -1;
+    return fd;
+}
+
+bool DirectoryReader::fill() {
+    long n = ::syscall(SYS_getdents64, dirFd, buffer.data(), buffer.size());
+    if (n < 0) {
+        ec.assign(errno, std::generic_category());
+        return false;
+    }
+    bufferPos = 0;
+    bufferLen = size_t(n);
+    return n > 0;
+}
+
+bool DirectoryReader::classify(const char* name, unsigned char dType, DirEntryInfo& info) {
+    info.hasStat = info.hasSize = info.hasMtime = false;
+    switch (dType) {
+        case DT_DIR:
+            info.type = FileEntryType::Directory;
+            return true;
+        case DT_REG:
+            info.type = FileEntryType::File;
+            return true;
+        case DT_LNK:
+        case DT_UNKNOWN:
+            break; // Need to ask the file system.
+        default:
+            return false; // Devices, sockets, pipes.
+    }
+
+    // Only the type is needed. AT_STATX_DONT_SYNC avoids a round trip to the
+    // server on network file systems when cached attributes are available.
+    struct statx stx;
+    if (::statx(dirFd, name, AT_STATX_DONT_SYNC, STATX_TYPE | STATX_MODE, &stx) != 0) {
+        return false; // Dangling symlink or the entry vanished meanwhile.
+    }
+    if (S_ISDIR(stx.stx_mode)) {
+        info.type = FileEntryType::Directory;
+    } else if (S_ISREG(stx.stx_mode)) {
+        info.type = FileEntryType::File;
+    } else {
+        return false;
+    }
+    // The kernel usually fills in more than it was asked for; keep it.
+    info.hasStat = true;
+    info.mode = stx.stx_mode;
+    info.hasSize = (stx.stx_mask & STATX_SIZE) != 0;
+    info.size = stx.stx_size;
+    info.hasMtime = (stx.stx_mask & STATX_MTIME) != 0;
+    info.mtime = stx.stx_mtime.tv_sec;
+    return true;
+}
+
+bool DirectoryReader::next(DirEntryInfo& info) {
+    if (dirFd < 0) return false;
+    for (;;) {
+        if (bufferPos >= bufferLen && !fill()) return false;
+
+        auto* d = reinterpret_cast<const LinuxDirent64*>(buffer.data() + bufferPos);
+        bufferPos += d->d_reclen;
+
+        if (isDotOrDotDot(d->d_name)) continue;
+        if (classify(d->d_name, d->d_type, info)) {
+            info.name = d->d_name;
+            return true;
+        }
+    }
+}
+
+bool DirectoryReader::nextEntry(std::string_view& name, bool& isDirectory) {
+    if (dirFd < 0) return false;
+    for (;;) {
+        if (bufferPos >= bufferLen && !fill()) return false;
+
+        auto* d = reinterpret_cast<const LinuxDirent64*>(buffer.data() + bufferPos);
+        bufferPos += d->d_reclen;
+
+        if (isDotOrDotDot(d->d_name)) continue;
+        isDirectory = d->d_type == DT_DIR;
+        if (d->d_type == DT_UNKNOWN) {
+            struct stat st;
+            isDirectory = ::fstatat(dirFd, d->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+        name = d->d_name;
+        return true;
+    }
+}
+
+bool DirectoryReader::stat(DirEntryInfo& info) {
+    if (info.hasStat && info.hasSize && info.hasMtime) return true;
+    // info.name points into the getdents64 buffer and is NUL-terminated.
+    struct statx stx;
+    if (::statx(dirFd, info.name.data(), AT_STATX_DONT_SYNC, STATX_MODE | STATX_SIZE | STATX_MTIME, &stx) != 0) {
+        return false;
+    }
+    info.hasStat = info.hasSize = info.hasMtime = true;
+    info.mode = stx.stx_mode;
+    info.size = stx.stx_size;
+    info.mtime = stx.stx_mtime.tv_sec;
+    return true;
+}
+
+bool statDirEntry(int dirFd, const char* name, DirEntryInfo& info) {
+    struct statx stx;
+    if (::statx(dirFd, name, AT_STATX_DONT_SYNC, STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, &stx) != 0) {
+        return false;
+    }
+    if (S_ISDIR(stx.stx_mode)) {
+        info.type = FileEntryType::Directory;
+    } else if (S_ISREG(stx.stx_mode)) {
+        info.type = FileEntryType::File;
+    } else {
+        return false;
+    }
+    info.name = name;
+    info.hasStat = info.hasSize = info.hasMtime = true;
+    info.mode = stx.stx_mode;
+    info.size = stx.stx_size;
+    info.mtime = stx.stx_mtime.tv_sec;
+    return true;
+}
+
+bool statDirEntry(const std::filesystem::path& path, DirEntryInfo& info) {
+    bool found = statDirEntry(AT_FDCWD, path.c_str(), info);
+    info.name = {};
+    return found;
+}
+
+#else
+
+DirectoryReader::DirectoryReader(const std::filesystem::path& dir)
+    : it(dir, ec) {
+}
+
+// Descriptor-relative walking is only implemented for Linux.
+DirectoryReader::DirectoryReader(int, const char*)
+    : ec(std::make_error_code(std::errc::not_supported)) {
+}
+
+DirectoryReader::~DirectoryReader() = default;
+
+int DirectoryReader::release() {
+    return -1;
+}
+
+bool DirectoryReader::nextEntry(std::string_view&, bool&) {
+    return false;
+}
+
+bool DirectoryReader::next(DirEntryInfo& info) {
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::error_code entryEc;
+        info.hasStat = info.hasSize = info.hasMtime = false;
+        if (it->is_directory(entryEc)) {
+            info.type = FileEntryType::Directory;
+        } else if (it->is_regular_file(entryEc)) {
+            info.type = FileEntryType::File;
+        } else {
+            continue;
+        }
+        current = *it;
+        currentName = current.path().filename().string();
+        info.name = currentName;
+        it.increment(ec);
+        return true;
+    }
+    return false;
+}
+
+bool DirectoryReader::stat(DirEntryInfo& info) {
+    if (info.hasStat && info.hasSize && info.hasMtime) return true;
+    std::error_code statEc;
+    auto status = current.status(statEc);
+    if (statEc) return false;
+    auto size = current.is_regular_file(statEc) ? current.file_size(statEc) : 0;
+    auto mtime = current.last_write_time(statEc);
+    if (statEc) return false;
+    info.hasStat = info.hasSize = info.hasMtime = true;
+    info.mode = uint32_t(status.permissions());
+    info.size = size;
+    info.mtime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::clock_cast<std::chrono::system_clock>(mtime).time_since_epoch()).count();
+    return true;
+}
+
+bool statDirEntry(int, const char*, DirEntryInfo&) {
+    return false;
+}
+
+bool statDirEntry(const std::filesystem::path& path, DirEntryInfo& info) {
+    std::error_code ec;
+    auto status = std::filesystem::status(path, ec);
+    if (ec) return false;
+    if (std::filesystem::is_directory(status)) {
+        info.type = FileEntryType::Directory;
+    } else if (std::filesystem::is_regular_file(status)) {
+        info.type = FileEntryType::File;
+    } else {
+        return false;
+    }
+    auto size = info.type == FileEntryType::File ? std::filesystem::file_size(path, ec) : 0;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    info.name = {};
+    info.hasStat = info.hasSize = info.hasMtime = !ec;
+    info.mode = uint32_t(status.permissions());
+    info.size = size;
+    info.mtime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::clock_cast<std::chrono::system_clock>(mtime).time_since_epoch()).count();
+    return true;
+}
+
+#endif
@@ -0,0 +1,178 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DIRREAD_H
+#define DIRREAD_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "filelist.h"
+
+// One directory entry as returned by DirectoryReader::next().
+struct DirEntryInfo {
+    std::string_view name;   // Valid until the next call to next().
+    FileEntryType type;
+    // True when the type had to be obtained with statx() (symlinks, file systems
+    // that don't fill in d_type). Whatever metadata that call returned is kept
+    // below so that later columns can use it without another system call.
+    bool hasStat = false;
+    bool hasSize = false;
+    bool hasMtime = false;
+    uint32_t mode = 0;
+    uint64_t size = 0;
+    int64_t mtime = 0;       // Seconds since the epoch.
+};
+
+// A fast, allocation-free directory reader. On Linux it reads raw records with
+// getdents64() into a large buffer and only falls back to statx() for entries
+// whose type is not reported by the file system, asking for the minimal mask.
+// Other platforms go through std::filesystem::directory_iterator.
+//
+// Like the old std::filesystem based loop, only directories and regular files
+// are reported (following symlinks); "." and ".." are skipped.
+class DirectoryReader {
+public:
+    explicit DirectoryReader(const std::filesystem::path& dir);
+    // Opens 'name' in the directory 'parentFd' refers to, without following a
+    // symlink, so that walking a tree doesn't resolve every path again.
+    DirectoryReader(int parentFd, const char* name);
+    ~DirectoryReader();
+
+    DirectoryReader(const DirectoryReader&) = delete;
+    DirectoryReader& operator=(const DirectoryReader&) = delete;
+
+    // Returns false at the end of the directory or on error (see error()).
+    bool next(DirEntryInfo& info);
+    // Fills in the size, mtime and mode of the entry last returned by next(),
+    // if they aren't known yet. Returns false if the entry can't be stat'ed.
+    bool stat(DirEntryInfo& info);
+    // Like next(), but returns every entry and never follows symlinks:
+    // 'isDirectory' is only set for real directories. Needs no system call
+    // unless the file system leaves out d_type. 'name' is NUL-terminated.
+    bool nextEntry(std::string_view& name, bool& isDirectory);
+
+    const std::error_code& error() const { return ec; }
+    // The open directory descriptor, for *at() calls relative to it; -1 if unavailable.
+    int fd() const { return dirFd; }
+    // Hands the directory descriptor over to the caller, who has to close it.
+    int release();
+
+private:
+    bool fill();
+    bool classify(const char* name, unsigned char dType, DirEntryInfo& info);
+
+    int dirFd = -1;
+    std::vector<char> buffer;
+    size_t bufferPos = 0;
+    size_t bufferLen = 0;
+    std::error_code ec;
+#ifndef __linux__
+    std::filesystem::directory_iterator it;
+    std::filesystem::directory_entry current;
+    std::string currentName;
+#endif
+};
+
+// Looks up a single entry of the directory open as 'dirFd', following symlinks
+// and reading its metadata. Returns false if it doesn't exist or is neither a
+// directory nor a regular file. Linux only; elsewhere it always fails.
+// 'info.name' is set to 'name'.
+bool statDirEntry(int dirFd, const char* name, DirEntryInfo& info);
+// The same for a full path. Works everywhere. 'info.name' is left empty.
+bool statDirEntry(const std::filesystem::path& path, DirEntryInfo& info);
+
+// Copies the metadata in 'info', if complete, to a listing entry.
+inline void copyMetadata(const DirEntryInfo& info, FileEntry& e) {
+    if (info.hasStat && info.hasSize && info.hasMtime) {
+        e.hasStat = true;
+        e.mode = info.mode;
+        e.size = info.size;
+        e.mtime = info.mtime;
+    }
+}
+
+#endif // DIRREAD_H
@@ -0,0 +1,284 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "dirsize.h"
+#include "asyncq.h"
+#include "dirread.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#endif
+
+namespace {
+
+constexpr size_t WORKER_COUNT = 8;
+constexpr auto REPORT_INTERVAL = std::chrono::milliseconds(100);
+// Entries read between checks for a cancellation.
+constexpr size_t CANCEL_CHECK_INTERVAL = 1024;
+
+int64_t now() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}
+
+bool DirSizeCache::get(uint64_t device, uint64_t inode, int64_t mtimeNs, Entry& entry) {
+    std::lock_guard lock(mutex);
+    auto it = entries.find({device, inode});
+    if (it == entries.end() || it->second.mtimeNs != mtimeNs) {
+        ++counters.misses;
+        return false;
+    }
+    ++counters.hits;
+    entry = it->second;
+    return true;
+}
+
+void DirSizeCache::put(uint64_t device, uint64_t inode, Entry entry) {
+    constexpr size_t ENTRY_OVERHEAD = sizeof(Key) + sizeof(Entry) + 2 * sizeof(void*);
+    std::lock_guard lock(mutex);
+    auto [it, inserted] = entries.try_emplace({device, inode});
+    if (!inserted) counters.bytes -= ENTRY_OVERHEAD + it->second.subdirectories.size();
+    it->second = std::move(entry);
+    counters.bytes += ENTRY_OVERHEAD + it->second.subdirectories.size();
+    if (counters.bytes > capacity) {
+        // Rather than keeping track of what was used when, start over; the
+        // trees in use are back after one more calculation each.
+        entries.clear();
+        counters.bytes = 0;
+    }
+    counters.entries = entries.size();
+}
+
+DirSizeCache::Stats DirSizeCache::stats() {
+    std::lock_guard lock(mutex);
+    return counters;
+}
+
+DirectorySizer::DirectorySizer(ResultHandler aOnResult, DirSizeCache* aCache)
+    : onResult(std::move(aOnResult)), cache(aCache), queues(WORKER_COUNT) {
+}
+
+DirectorySizer::~DirectorySizer() {
+    for (auto& w : workers) {
+        w.request_stop();
+    }
+    workers.clear(); // std::jthread joins on destruction.
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void DirectorySizer::calculate(const std::filesystem::path& dir, const FileList& list, const std::vector<size_t>& indexes) {
+    if (indexes.empty()) return;
+    if (workers.empty()) {
+        for (size_t w = 0; w < queues.size(); ++w) {
+            workers.emplace_back([this, w](std::stop_token stop) { work(w, stop); });
+        }
+    }
+
+    // Spread over the queues; the workers balance the rest by stealing.
+    std::vector<std::vector<Task>> tasks(queues.size());
+    for (size_t k = 0; k < indexes.size(); ++k) {
+        const FileEntry& e = list[indexes[k]];
+        auto request = std::make_shared<Request>();
+        request->key = {e.nameOffset, uint32_t(indexes[k])};
+        request->generation = generation;
+        request->lastReport = now();
+        tasks[k % tasks.size()].push_back({std::move(request), (dir / list.name(e)).string()});
+    }
+    running += indexes.size();
+    for (size_t q = 0; q < tasks.size(); ++q) {
+        queues.push(q, tasks[q]);
+    }
+}
+
+void DirectorySizer::cancel() {
+    ++generation;
+    running = 0;
+    queues.clear();
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void DirectorySizer::work(size_t self, std::stop_token stop) {
+    Task task;
+    while (!stop.stop_requested()) {
+        if (queues.take(self, task)) {
+            read(self, task, stop);
+            task = {};
+        } else if (!queues.wait(stop)) {
+            return; // Stop requested.
+        }
+    }
+}
+
+void DirectorySizer::read(size_t self, Task& task, std::stop_token stop) {
+    const std::shared_ptr<Request>& request = task.request;
+    auto stale = [&] { return stop.stop_requested() || generation != request->generation; };
+    if (stale()) return;
+
+    DirSizeCache::Entry entry;
+#ifdef __linux__
+    // The mtime is taken before reading, so that a change meanwhile makes the
+    // cached entry stale rather than wrong.
+    struct statx dirStat;
+    bool cacheable = cache && ::statx(AT_FDCWD, task.path.c_str(), AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC,
+                                      STATX_INO | STATX_MTIME, &dirStat) == 0;
+    uint64_t device = cacheable ? makedev(dirStat.stx_dev_major, dirStat.stx_dev_minor) : 0;
+    int64_t mtimeNs = cacheable ? int64_t(dirStat.stx_mtime.tv_sec) * 1000000000 + dirStat.stx_mtime.tv_nsec : 0;
+    if (!cacheable || !cache->get(device, dirStat.stx_ino, mtimeNs, entry)) {
+        entry.mtimeNs = mtimeNs;
+        // Symlinks count as themselves; the trees they point to aren't part of this one.
+        DirectoryReader reader(task.path);
+        std::string_view name;
+        bool isDirectory;
+        size_t count = 0;
+        while (reader.nextEntry(name, isDirectory)) {
+            if (++count % CANCEL_CHECK_INTERVAL == 0 && stale()) return;
+            if (isDirectory) {
+                entry.subdirectories.append(name);
+                entry.subdirectories.push_back('\0');
+                continue;
+            }
+            struct statx stx;
+            if (::statx(reader.fd(), name.data(), AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, STATX_SIZE, &stx) == 0) {
+                entry.bytes += stx.stx_size;
+                ++entry.files;
+            }
+        }
+        if (cacheable && !reader.error()) cache->put(device, dirStat.stx_ino, entry);
+    }
+#else
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(task.path, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryEc;
+        auto status = it->symlink_status(entryEc);
+        if (std::filesystem::is_directory(status)) {
+            entry.subdirectories.append(it->path().filename().string());
+            entry.subdirectories.push_back('\0');
+        } else if (std::filesystem::is_regular_file(status)) {
+            entry.bytes += it->file_size(entryEc);
+            ++entry.files;
+        }
+    }
+#endif
+    request->bytes += entry.bytes;
+    request->files += entry.files;
+
+    // Onto this worker's own queue; idle ones take their share from there.
+    std::vector<Task> subtasks;
+    for (size_t begin = 0, end; begin < entry.subdirectories.size(); begin = end + 1) {
+        end = entry.subdirectories.find('\0', begin);
+        std::string path = task.path;
+        path += '/';
+        path.append(entry.subdirectories, begin, end - begin);
+        subtasks.push_back({request, std::move(path)});
+    }
+    request->pending += subtasks.size();
+    queues.push(self, subtasks);
+
+    if (--request->pending == 0) {
+        request->done = true;
+        report(request, true);
+        return;
+    }
+    int64_t last = request->lastReport;
+    int64_t t = now();
+    if (t - last >= std::chrono::steady_clock::duration(REPORT_INTERVAL).count()
+        && request->lastReport.compare_exchange_strong(last, t)) {
+        report(request, false);
+    }
+}
+
+void DirectorySizer::report(const std::shared_ptr<Request>& request, bool done) {
+    Result result {request->key, request->bytes, request->files, done};
+    // Only the UI thread may use onResult; the worker merely uses 'this' as a token.
+    AsyncQueue::getInstance().post(this, [this, request, result]() mutable {
+        if (generation != request->generation) return;
+        // A partial total may be posted after the final one by another worker.
+        if (!result.done && request->done) return;
+        if (result.done) --running;
+        onResult(result);
+    });
+}
@@ -0,0 +1,211 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef DIRSIZE_H
+#define DIRSIZE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "filelist.h"
+#include "metafetch.h"
+#include "wsqueue.h"
+
+// What DirectorySizer found in directories it has read before, by device and
+// inode. An entry holds only the directory's own files, plus the names of
+// its subdirectories, so a tree is valid as far as it hasn't changed: a
+// repeated query reads just the directories that did and stats the others.
+// A directory's mtime doesn't change when a file in it is rewritten in
+// place, so such a file keeps its old size until something is added to or
+// removed from the directory. Shared by the workers of any number of sizers.
+class DirSizeCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 32 * 1024 * 1024;
+
+    struct Entry {
+        int64_t mtimeNs = 0;
+        uint64_t bytes = 0;         // Of the files directly in the directory.
+        uint64_t files = 0;
+        std::string subdirectories; // Their names, each followed by a NUL.
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0; // Including stale entries.
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    explicit DirSizeCache(size_t capacityBytes = DEFAULT_CAPACITY) : capacity(capacityBytes) {}
+
+    // Copies the entry of the directory to 'entry' if there is one for the
+    // 'mtimeNs' it has now.
+    bool get(uint64_t device, uint64_t inode, int64_t mtimeNs, Entry& entry);
+    // 'entry.mtimeNs' must be from before the directory was read.
+    void put(uint64_t device, uint64_t inode, Entry entry);
+
+    Stats stats();
+
+private:
+    struct Key {
+        uint64_t device;
+        uint64_t inode;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return std::hash<uint64_t>()(k.inode * 31 + k.device); }
+    };
+
+    size_t capacity;
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    Stats counters;
+};
+
+// Adds up the sizes of the files in directory trees, for the panel's size
+// column. The trees are read by a pool of workers, a directory at a time:
+// each worker takes the subdirectories it finds onto its own queue and the
+// others steal from it when they run out, so a single deep tree keeps all of
+// them busy (see StealingQueues). Totals are reported as they grow and once more when complete.
+class DirectorySizer {
+public:
+    struct Result {
+        MetadataFetcher::Key key;
+        uint64_t bytes;
+        uint64_t files;
+        bool done; // Otherwise a partial total.
+    };
+    using ResultHandler = std::function<void(Result& result)>;
+
+    // 'onResult' is invoked on the UI thread (via AsyncQueue). 'cache' may be
+    // null; it isn't owned.
+    DirectorySizer(ResultHandler onResult, DirSizeCache* cache);
+    ~DirectorySizer();
+
+    DirectorySizer(const DirectorySizer&) = delete;
+    DirectorySizer& operator=(const DirectorySizer&) = delete;
+
+    // Queues the directories of 'list' at 'indexes', entries of 'dir'.
+    void calculate(const std::filesystem::path& dir, const FileList& list, const std::vector<size_t>& indexes);
+    // Drops everything queued and the results of what is running.
+    void cancel();
+    // True while a calculation hasn't finished or been cancelled.
+    bool isRunning() const { return running > 0; }
+
+private:
+    // One of the directories asked for; its tree's totals.
+    struct Request {
+        MetadataFetcher::Key key;
+        unsigned generation;
+        std::atomic<uint64_t> bytes {0};
+        std::atomic<uint64_t> files {0};
+        std::atomic<size_t> pending {1}; // Directories of the tree not read yet.
+        std::atomic<int64_t> lastReport {0}; // steady_clock ticks.
+        std::atomic<bool> done {false};
+    };
+    struct Task {
+        std::shared_ptr<Request> request;
+        std::string path;
+    };
+    void work(size_t self, std::stop_token stop);
+    void read(size_t self, Task& task, std::stop_token stop);
+    void report(const std::shared_ptr<Request>& request, bool done);
+
+    ResultHandler onResult;
+    DirSizeCache* cache;
+    std::atomic<unsigned> generation {0};
+    size_t running = 0; // Requests not done yet; UI thread only.
+
+    StealingQueues<Task> queues; // One per worker.
+    std::vector<std::jthread> workers; // Started on the first calculate().
+};
+
+#endif // DIRSIZE_H
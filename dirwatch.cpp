@@ -0,0 +1,265 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "dirwatch.h"
+#include "dirread.h"
+#include "asyncq.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Events are flushed once the directory has been quiet for QUIET_PERIOD, but
+// no later than MAX_DELAY after the first one, so that a build writing
+// thousands of files still shows progress.
+constexpr int QUIET_PERIOD_MS = 50;
+constexpr auto MAX_DELAY = std::chrono::milliseconds(500);
+// Past this many distinct names it is cheaper to simply reload everything.
+constexpr size_t MAX_PENDING_NAMES = 100000;
+
+}
+
+#ifdef __linux__
+
+DirectoryWatcher::~DirectoryWatcher() {
+    stop();
+    for (auto& w : workers) {
+        w.thread.join();
+        ::close(w.wakeFd);
+    }
+    // What they posted before they stopped.
+    AsyncQueue::getInstance().cancel(this);
+}
+
+bool DirectoryWatcher::start(const std::filesystem::path& dir, ChangeHandler aOnChange) {
+    stop();
+    reapWorkers();
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) return false;
+    constexpr uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY |
+        IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+    int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (dirFd < 0 || wakeFd < 0 || inotify_add_watch(inotifyFd, dir.c_str(), mask) < 0) {
+        ::close(inotifyFd);
+        if (dirFd >= 0) ::close(dirFd);
+        if (wakeFd >= 0) ::close(wakeFd);
+        return false;
+    }
+
+    onChange = std::move(aOnChange);
+    active = true;
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    workers.push_back({std::jthread(&DirectoryWatcher::run, inotifyFd, dirFd, wakeFd, this, generation, done),
+                       wakeFd, done});
+    return true;
+}
+
+void DirectoryWatcher::stop() {
+    ++generation;
+    active = false;
+    // The worker is not joined here, as this runs on every directory change:
+    // it may be busy stat()ing a burst of names on a slow mount. It wakes up,
+    // notices the stop request and is reaped later.
+    for (auto& w : workers) {
+        if (w.thread.get_stop_source().stop_requested()) continue;
+        w.thread.request_stop();
+        uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(w.wakeFd, &one, sizeof(one));
+    }
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void DirectoryWatcher::reapWorkers() {
+    std::erase_if(workers, [](Worker& w) {
+        if (!w.done->load()) return false;
+        w.thread.join();
+        ::close(w.wakeFd);
+        return true;
+    });
+}
+
+void DirectoryWatcher::run(std::stop_token stop, int inotifyFd, int dirFd, int wakeFd,
+                           DirectoryWatcher* self, unsigned generation, std::shared_ptr<std::atomic<bool>> done) {
+    using Clock = std::chrono::steady_clock;
+    // Large enough for many events per read(); aligned as inotify_event requires.
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    std::unordered_set<std::string> pendingNames;
+    bool rescan = false;
+    Clock::time_point firstEvent;
+
+    pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+    while (!stop.stop_requested()) {
+        bool pending = rescan || !pendingNames.empty();
+        int timeout = -1;
+        if (pending) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(firstEvent + MAX_DELAY - Clock::now());
+            timeout = std::max(0, std::min<int>(QUIET_PERIOD_MS, left.count()));
+        }
+        int n = ::poll(fds, 2, timeout);
+        if (n < 0 && errno != EINTR) break;
+        if (stop.stop_requested()) break;
+
+        if (n > 0 && (fds[0].revents & POLLIN)) {
+            ssize_t len;
+            while ((len = ::read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                if (!pending) {
+                    firstEvent = Clock::now();
+                    pending = true;
+                }
+                for (char* p = buffer; p < buffer + len;) {
+                    auto* ev = reinterpret_cast<struct inotify_event*>(p);
+                    p += sizeof(struct inotify_event) + ev->len;
+                    if (ev->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                        rescan = true;
+                    } else if (ev->len > 0 && !rescan) {
+                        pendingNames.emplace(ev->name);
+                    }
+                }
+                if (pendingNames.size() > MAX_PENDING_NAMES) {
+                    rescan = true;
+                }
+            }
+            if (rescan) pendingNames.clear();
+            // Keep gathering until things calm down or the deadline passes.
+            if (Clock::now() - firstEvent < MAX_DELAY) continue;
+        }
+
+        if (!rescan && pendingNames.empty()) continue;
+
+        // Flush: look at what each name refers to now.
+        DirectoryChanges changes;
+        changes.rescan = rescan;
+        DirEntryInfo info;
+        for (const auto& name : pendingNames) {
+            if (statDirEntry(dirFd, name.c_str(), info)) {
+                copyMetadata(info, changes.updated.add(name, info.type));
+            } else {
+                changes.removed.add(name, FileEntryType::File);
+            }
+        }
+        pendingNames.clear();
+        rescan = false;
+
+        AsyncQueue::getInstance().post(self, [self, generation, changes = std::move(changes)]() mutable {
+            if (self->generation == generation) self->onChange(changes);
+        });
+    }
+
+    ::close(dirFd);
+    ::close(inotifyFd);
+    done->store(true);
+}
+
+#else
+
+DirectoryWatcher::~DirectoryWatcher() {
+}
+
+bool DirectoryWatcher::start(const std::filesystem::path&, ChangeHandler) {
+    return false;
+}
+
+void DirectoryWatcher::stop() {
+}
+
+void DirectoryWatcher::reapWorkers() {
+}
+
+void DirectoryWatcher::run(std::stop_token, int, int, int, DirectoryWatcher*, unsigned, std::shared_ptr<std::atomic<bool>>) {
+}
+
+#endif
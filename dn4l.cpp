@@ -82,41 +82,56 @@
 
 #include "dnapp.h"
 #include "dnlogger.h"
+#include "dnprof.h"
+#include <cstdlib>
 #include <iostream>
 
 int main() {
+    // Messages below the level in DN4L_LOG (debug, info, warning, error or off)
+    // are skipped; levels compiled out by CMake can't be turned back on here.
+    if (const char* levelName = std::getenv("DN4L_LOG")) {
+        LogLevel level;
+        if (Logger::parseLevel(levelName, level)) Logger::setLevel(level);
+    }
+    // With DN4L_TRACE set, messages go to dn4l.trace in a compact binary form
+    // instead; dn4l_tracedump turns it back into text or JSON.
+    if (std::getenv("DN4L_TRACE")) {
+        Logger::getInstance().setSink(Logger::Sink::Binary);
+    }
+
     // The Logger is a singleton, accessed via getInstance().
     // This approach avoids the 'static initialization order fiasco'.
-    Logger::getInstance().log("--------------------------------------------------");
-    Logger::getInstance().log("APPLICATION START");
-    Logger::getInstance().log("--------------------------------------------------");
+    DNLOG_INFO("--------------------------------------------------");
+    DNLOG_INFO("APPLICATION START");
+    DNLOG_INFO("--------------------------------------------------");
 
     try {
         // The TDNApp constructor handles Turbo Vision initialization through TProgInit.
         TDNApp app;
-        Logger::getInstance().log("TDNApp instance created, TProgInit should have run.");
+        DNLOG_DEBUG("TDNApp instance created, TProgInit should have run.");
 
         // Run the application's main event loop. This blocks until the app exits.
         app.run();
-        Logger::getInstance().log("TDNApp::run() completed.");
+        DNLOG_DEBUG("TDNApp::run() completed.");
+        Profiler::getInstance().report();
 
         // shutDown() is called automatically by TApplication's destructor.
         // Calling it explicitly is not necessary but doesn't harm.
         // app.shutDown();
-        Logger::getInstance().log("TDNApp has shut down.");
+        DNLOG_DEBUG("TDNApp has shut down.");
 
     } catch (const std::exception& e) {
         // Catch any standard exceptions that might occur during initialization or runtime.
-        Logger::getInstance().log(std::format("FATAL EXCEPTION: {}", e.what()));
+        DNLOG_ERROR("FATAL EXCEPTION", e.what());
         // Also print to stderr in case the logger itself failed.
         std::cerr << "A fatal error occurred: " << e.what() << std::endl;
         return 1;
     }
 
-    Logger::getInstance().log("Application finished normally.");
-    Logger::getInstance().log("--------------------------------------------------");
-    Logger::getInstance().log("APPLICATION END");
-    Logger::getInstance().log("--------------------------------------------------");
+    DNLOG_INFO("Application finished normally.");
+    DNLOG_INFO("--------------------------------------------------");
+    DNLOG_INFO("APPLICATION END");
+    DNLOG_INFO("--------------------------------------------------");
 
     // The Logger's destructor will be called automatically at program exit,
     // closing the log file.
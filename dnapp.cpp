@@ -84,8 +84,15 @@
 #include "dblwnd.h"
 #include "flpanel.h"
 #include "dnlogger.h"
+#include "asyncq.h"
+#include "dnprof.h"
+#include "profview.h"
+#include "xferwnd.h"
+#include "searchwnd.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <format>
 #include <system_error>
 #include <vector>
 
@@ -94,9 +101,19 @@
 TDNApp::TDNApp() :
     TProgInit(&TDNApp::initStatusLine,
               &TDNApp::initMenuBar,
-              &TDNApp::initDeskTop)
+              &TDNApp::initDeskTop),
+    transfers([this](const auto& progress) { onTransferProgress(progress); },
+              [this](auto& result) { onTransferFinished(result); })
 {
-    Logger::getInstance().log("TDNApp constructor finished.");
+    // The timing overlay sits on the menu bar, to the right of the menus.
+    TRect r = getExtent();
+    r.b.y = r.a.y + 1;
+    r.a.x = std::min<int>(r.a.x + 10, r.b.x);
+    profileView = new TProfileView(r);
+    profileView->hide();
+    insert(profileView);
+
+    DNLOG_DEBUG("TDNApp constructor finished.");
 }
 
 TMenuBar* TDNApp::initMenuBar(TRect r) {
@@ -124,7 +141,12 @@ TStatusLine* TDNApp::initStatusLine(TRect r) {
         *new TStatusDef(0, 0xFFFF) +
             *new TStatusItem("~Alt-X~ Exit", kbAltX, cmQuit) +
             *new TStatusItem("~F7~ MkDir", kbF7, cmCreateDirectory) +
-            *new TStatusItem("~Alt+A~ MkDir", kbAltA, cmCreateDirectory) // For tests
+            *new TStatusItem("~Alt+A~ MkDir", kbAltA, cmCreateDirectory) + // For tests
+            *new TStatusItem("~F5~ Copy", kbF5, cmCopy) +
+            *new TStatusItem("~F6~ Move", kbF6, cmMove) +
+            *new TStatusItem("~F8~ Delete", kbF8, cmDelete) +
+            *new TStatusItem("~Alt-F7~ Find", kbAltF7, cmFindFile) +
+            *new TStatusItem(0, kbAltF12, cmToggleProfile) // Not shown; just binds the key.
     );
 }
 
@@ -140,7 +162,29 @@ TDeskTop* TDNApp::initDeskTop(TRect r) {
     return deskTop;
 }
 
+void TDNApp::getEvent(TEvent& event) {
+    TApplication::getEvent(event);
+
+    // Background workers wake up the event loop after posting to AsyncQueue.
+    // Their results are delivered as a command so that they are processed in
+    // handleEvent() like any other event, between keystrokes.
+    if (event.what == evNothing && AsyncQueue::getInstance().hasPending()) {
+        event.what = evCommand;
+        event.message.command = cmDispatchAsync;
+        event.message.infoPtr = nullptr;
+    }
+}
+
+void TDNApp::idle() {
+    TApplication::idle();
+    profileView->update();
+}
+
 void TDNApp::handleEvent(TEvent& event) {
+    // Covers the redraws the event causes too. Modal dialogs opened from here
+    // run their own event loop inside it and show up as outliers.
+    ScopedTimer timer(Probe::HandleEvent);
+
     // First, let the base class handle standard events (like cmQuit).
     TApplication::handleEvent(event);
 
@@ -165,14 +209,16 @@ void TDNApp::handleEvent(TEvent& event) {
                     std::string nameStr(dirName.data()); // Create string from null-terminated buffer.
                     if (!nameStr.empty()) {
                         auto newDirPath = activePanel->getCurrentPath() / nameStr;
-                        Logger::getInstance().log("Attempting to create directory", newDirPath.string());
+                        DNLOG_INFO("Attempting to create directory", newDirPath.string());
 
                         std::error_code ec;
                         if (std::filesystem::create_directory(newDirPath, ec)) {
-                            Logger::getInstance().log("Directory created successfully");
-                            activePanel->loadDirectory(activePanel->getCurrentPath()); // Refresh panel
+                            DNLOG_INFO("Directory created successfully");
+                            // Show and focus the new entry without rescanning the whole directory.
+                            activePanel->refreshEntry(nameStr);
+                            activePanel->focusEntry(nameStr);
                         } else {
-                            Logger::getInstance().log("Failed to create directory", ec.message());
+                            DNLOG_ERROR("Failed to create directory", ec.message());
                             messageBox(std::format("Error: {}", ec.message()), mfError | mfOKButton);
                         }
                     }
@@ -180,8 +226,155 @@ void TDNApp::handleEvent(TEvent& event) {
                 clearEvent(event); // We've handled this command.
                 break;
             }
+            case cmCopy:
+                transfer(TransferKind::Copy);
+                clearEvent(event);
+                break;
+            case cmMove:
+                transfer(TransferKind::Move);
+                clearEvent(event);
+                break;
+            case cmDelete:
+                transfer(TransferKind::Delete);
+                clearEvent(event);
+                break;
+            case cmFindFile:
+                findFile();
+                clearEvent(event);
+                break;
+            case cmToggleProfile:
+                if (profileView->state & sfVisible) {
+                    profileView->hide();
+                } else {
+                    profileView->show();
+                }
+                clearEvent(event);
+                break;
+            case cmDispatchAsync:
+                AsyncQueue::getInstance().dispatch();
+                clearEvent(event);
+                break;
             default:
                 break;
         }
+    } else if (event.what == evKeyDown && event.keyDown.keyCode == kbEsc && transfers.isBusy()) {
+        // Nothing focused wanted the key, so it's for the transfer in progress.
+        clearEvent(event);
+        if (messageBox("Cancel the file operations in progress?", mfConfirmation | mfYesButton | mfNoButton) == cmYes) {
+            transfers.cancelAll();
+        }
+    }
+}
+
+void TDNApp::transfer(TransferKind kind) {
+    auto* dblWin = dynamic_cast<TDoublePanelWindow*>(deskTop->current);
+    if (!dblWin) return;
+    auto* source = dynamic_cast<TFilePanel*>(dblWin->current);
+    if (!source) return;
+    TFilePanel* target = source == dblWin->leftPanel ? dblWin->rightPanel : dblWin->leftPanel;
+
+    // The selected entries, or else the focused one.
+    std::vector<std::string> names = source->selectedNames();
+    if (names.empty()) {
+        std::string name(source->focusedName());
+        if (name.empty() || name == "..") return;
+        names.push_back(std::move(name));
     }
+    std::string what = names.size() == 1 ? std::format("\"{}\"", names.front()) : std::format("{} files", names.size());
+    std::vector<std::filesystem::path> sources;
+    for (const auto& name : names) sources.push_back(source->getCurrentPath() / name);
+
+    if (kind == TransferKind::Delete) {
+        if (messageBox(std::format("Do you wish to delete {}?", what), mfConfirmation | mfYesButton | mfNoButton) == cmYes) {
+            unsigned job = transfers.enqueue(kind, std::move(sources), {});
+            source->clearSelection();
+            DNLOG_INFO("Queued transfer job", job, "Delete", names.size());
+        }
+        return;
+    }
+
+    const char* verb = kind == TransferKind::Move ? "Move" : "Copy";
+    std::vector<char> destination(256, '\0');
+    target->getCurrentPath().string().copy(destination.data(), destination.size() - 1);
+    if (inputBox(verb, std::format("{} {} to:", verb, what), destination.data(), destination.size() - 1) != cmOK) {
+        return;
+    }
+    std::filesystem::path destPath(destination.data());
+    if (destPath.empty()) return;
+    // Like a shell does, a relative destination is relative to where the source is.
+    if (destPath.is_relative()) destPath = source->getCurrentPath() / destPath;
+
+    unsigned job = transfers.enqueue(kind, std::move(sources), destPath);
+    source->clearSelection();
+    DNLOG_INFO("Queued transfer job", job, verb, names.size(), destPath.string());
+    // The panels pick up the new and removed entries through their directory watchers.
+}
+
+void TDNApp::onTransferProgress(const TransferEngine::Progress& progress) {
+    if (!transferWindow) {
+        TRect r = deskTop->getExtent();
+        TPoint center = {(r.a.x + r.b.x) / 2, (r.a.y + r.b.y) / 2};
+        r.a.x = std::max(r.a.x, center.x - TTransferWindow::WIDTH / 2);
+        r.a.y = std::max(r.a.y, center.y - TTransferWindow::HEIGHT / 2);
+        r.b.x = std::min(r.b.x, r.a.x + TTransferWindow::WIDTH);
+        r.b.y = std::min(r.b.y, r.a.y + TTransferWindow::HEIGHT);
+        transferWindow = new TTransferWindow(r);
+        deskTop->insert(transferWindow);
+    }
+    transferWindow->update(progress);
+}
+
+void TDNApp::onTransferFinished(TransferEngine::Result& result) {
+    if (transferWindow && !transfers.isBusy()) {
+        TObject::destroy(transferWindow);
+        transferWindow = nullptr;
+    }
+    if (result.cancelled || result.errors.empty()) return;
+
+    std::string text = std::format("{} error(s) occurred. The first one:\n{}", result.errorCount, result.errors.front());
+    messageBox(text, mfError | mfOKButton);
+}
+
+void TDNApp::findFile() {
+    auto* dblWin = dynamic_cast<TDoublePanelWindow*>(deskTop->current);
+    if (!dblWin) return;
+    auto* panel = dynamic_cast<TFilePanel*>(dblWin->current);
+    if (!panel) return;
+
+    // Laid out for TDialog::setData()/getData(). Kept from one search to the
+    // next, as Dos Navigator does.
+    static struct {
+        char masks[128] = "*.*";
+        char text[128] = "";
+        ushort options = 0;
+    } data;
+
+    auto* dialog = new TDialog(TRect(0, 0, 52, 11), "Find File");
+    dialog->options |= ofCentered;
+    auto* masks = new TInputLine(TRect(16, 2, 49, 3), sizeof(data.masks));
+    dialog->insert(masks);
+    dialog->insert(new TLabel(TRect(2, 2, 15, 3), "File ~m~asks", masks));
+    auto* text = new TInputLine(TRect(16, 4, 49, 5), sizeof(data.text));
+    dialog->insert(text);
+    dialog->insert(new TLabel(TRect(2, 4, 15, 5), "~C~ontaining", text));
+    dialog->insert(new TCheckBoxes(TRect(16, 6, 36, 7), new TSItem("Case ~s~ensitive", nullptr)));
+    dialog->insert(new TButton(TRect(14, 8, 25, 10), "~F~ind", cmOK, bfDefault));
+    dialog->insert(new TButton(TRect(27, 8, 38, 10), "Cancel", cmCancel, bfNormal));
+    dialog->selectNext(False);
+    if (executeDialog(dialog, &data) != cmOK) return;
+
+    FileSearcher::Options options;
+    options.root = panel->getCurrentPath();
+    options.masks = data.masks;
+    options.text = data.text;
+    options.caseSensitive = data.options & 1;
+    DNLOG_INFO("Searching", options.root.string(), options.masks, options.text, options.caseSensitive);
+
+    // The panel and its window live as long as the application does.
+    deskTop->insert(new TSearchWindow(deskTop->getExtent(), std::move(options),
+        [dblWin, panel](const std::filesystem::path& path) {
+            dblWin->select();
+            panel->select();
+            panel->showEntry(path);
+        }));
 }
@@ -96,17 +96,42 @@
 #define Uses_TStatusItem
 #define Uses_TKeys
 #define Uses_MsgBox
+#define Uses_TDialog
+#define Uses_TInputLine
+#define Uses_TLabel
+#define Uses_TCheckBoxes
+#define Uses_TSItem
+#define Uses_TButton
 #include <tvision/tv.h>
 
+#include "transfer.h"
+
+class TProfileView;
+class TTransferWindow;
+
 class TDNApp : public TApplication {
 public:
     TDNApp();
 
     void handleEvent(TEvent& event) override;
+    void getEvent(TEvent& event) override;
+    void idle() override;
 
     // Custom application commands. Using a specific range (e.g., 300+)
     // avoids conflicts with standard Turbo Vision commands (cm...).
     static constexpr uint16_t cmCreateDirectory = 307;
+    // Generated by getEvent() when worker threads have posted results to AsyncQueue.
+    static constexpr uint16_t cmDispatchAsync = 308;
+    // Shows or hides the timing overlay (Alt+F12).
+    static constexpr uint16_t cmToggleProfile = 309;
+    // Copy or move the selected entries, or the focused one, to the other
+    // panel's directory (F5/F6).
+    static constexpr uint16_t cmCopy = 310;
+    static constexpr uint16_t cmMove = 311;
+    // Delete the selected entries or the focused one, after asking (F8).
+    static constexpr uint16_t cmDelete = 312;
+    // Search the active panel's directory tree for files (Alt+F7).
+    static constexpr uint16_t cmFindFile = 313;
 
 private:
     // These static methods are required by the TProgInit base class constructor.
@@ -114,6 +139,17 @@ private:
     static TMenuBar* initMenuBar(TRect bounds);
     static TStatusLine* initStatusLine(TRect bounds);
     static TDeskTop* initDeskTop(TRect bounds);
+
+    // Asks for the destination, or whether to delete, and queues the job.
+    void transfer(TransferKind kind);
+    void onTransferProgress(const TransferEngine::Progress& progress);
+    void onTransferFinished(TransferEngine::Result& result);
+    // Asks what to look for and opens a window with the search's results.
+    void findFile();
+
+    TProfileView* profileView; // Owned by the application group.
+    TransferEngine transfers;
+    TTransferWindow* transferWindow = nullptr; // Owned by the desktop while shown.
 };
 
 #endif // DNAPP_H
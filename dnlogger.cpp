@@ -86,17 +86,55 @@
 
 #include "dnlogger.h"
 
+#include <array>
 #include <iostream>
 #include <chrono>
+#include <filesystem>
+
+namespace {
+
+// How long the writer thread lets messages accumulate before writing them out.
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+constexpr std::string_view LEVEL_NAMES[] = {"debug", "info", "warning", "error", "off"};
+// As they appear in the log, padded to the same width.
+constexpr std::string_view LEVEL_TAGS[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+
+// Distinct format strings the binary sink assigns ids to. Messages built at
+// runtime could otherwise grow the table without bound.
+constexpr size_t MAX_FORMATS = 4096;
+
+template <typename T>
+void appendBytes(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+int64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
 
 Logger::Logger(const std::string& filePath)
-    : initialized(false), logFilePath(filePath), openFileError(false) {
+    : initialized(false), logFilePath(filePath),
+      traceFilePath(std::filesystem::path(filePath).replace_extension(".trace").string()),
+      openFileError(false), ring(new Record[RING_SIZE]) {
+    static_assert(sizeof(Record) == RECORD_SIZE);
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0);
+    for (size_t i = 0; i < RING_SIZE; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
     // The log file is opened lazily on the first log attempt.
 }
 
 Logger::~Logger() {
     if (initialized) {
-        log("Logger finalizing.");
+        // Make room for the last message first.
+        stopWriter();
+        drain();
+        mode = Mode::Sync;
+        log(LogLevel::Info, "Logger finalizing.");
         if (logFile.is_open()) {
             logFile.close();
         }
@@ -112,52 +150,266 @@ std::string Logger::getTimestamp() {
 void Logger::openLogFile() {
     if (initialized || openFileError) return;
 
-    logFile.open(logFilePath, std::ios::app);
+    bool binary = sink == Sink::Binary;
+    const std::string& path = binary ? traceFilePath : logFilePath;
+    logFile.open(path, std::ios::app | std::ios::binary);
     if (!logFile.is_open()) {
         // If the log file can't be opened, subsequent log calls will do nothing.
         // An error is printed to stderr as a fallback.
-        std::cerr << getTimestamp() << ": Error: Could not open log file: " << logFilePath << std::endl;
+        std::cerr << getTimestamp() << ": Error: Could not open log file: " << path << std::endl;
         openFileError = true;
         return;
     }
     initialized = true;
-    logFile << getTimestamp() << ": Logger initialized. Log file: " << logFilePath << std::endl;
+    if (binary) {
+        // Lets the decoder turn the steady clock timestamps into dates.
+        std::string session;
+        appendBytes(session, TraceTag::Session);
+        session.append(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+        appendBytes(session, steadyNanoseconds());
+        appendBytes(session, int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()));
+        logFile.write(session.data(), std::streamsize(session.size()));
+        logFile.flush();
+    } else {
+        logFile << getTimestamp() << " INFO  Logger initialized. Log file: " << path << std::endl;
+    }
+    if (mode == Mode::Async) {
+        startWriter();
+    }
 }
 
-void Logger::log(const std::string& message) {
-    if (!initialized) openLogFile();
-    if (initialized) {
-        logFile << getTimestamp() << ": " << message << std::endl;
+bool Logger::parseLevel(std::string_view name, LogLevel& level) {
+    for (size_t i = 0; i < std::size(LEVEL_NAMES); ++i) {
+        if (name == LEVEL_NAMES[i]) {
+            level = LogLevel(i);
+            return true;
+        }
     }
+    return false;
+}
+
+void Logger::setMode(Mode aMode) {
+    if (mode.exchange(aMode) == aMode || !initialized) return;
+    if (aMode == Mode::Async) {
+        startWriter();
+    } else {
+        stopWriter();
+        drain();
+    }
+}
+
+void Logger::flush() {
+    if (initialized) drain();
+}
+
+void Logger::startWriter() {
+    writer = std::jthread([this](std::stop_token stop) { writerLoop(stop); });
+}
+
+void Logger::stopWriter() {
+    if (writer.joinable()) {
+        writer.request_stop(); // Interrupts the wait in writerLoop().
+        writer.join();
+    }
+}
+
+void Logger::writerLoop(std::stop_token stop) {
+    while (!stop.stop_requested()) {
+        drain();
+        std::unique_lock lock(wakeMutex);
+        wake.wait_for(lock, stop, FLUSH_INTERVAL, [this] { return backlog() >= RING_SIZE / 2; });
+    }
+}
+
+Logger::Record* Logger::acquire() {
+    std::call_once(openFlag, [this] { openLogFile(); });
+    if (!initialized) return nullptr;
+
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Record& r = ring[pos & (RING_SIZE - 1)];
+        size_t seq = r.sequence.load(std::memory_order_acquire);
+        auto diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                r.position = pos;
+                r.time = sink == Sink::Binary ? steadyNanoseconds()
+                                              : std::chrono::system_clock::now().time_since_epoch().count();
+                return &r;
+            }
+        } else if (diff < 0) {
+            // The ring is full.
+            if (mode == Mode::Sync) {
+                drain();
+            } else if (overflowPolicy == OverflowPolicy::Drop) {
+                // The first loss in a while wakes the writer up early.
+                if (dropped.fetch_add(1, std::memory_order_relaxed) == 0) wake.notify_one();
+                return nullptr;
+            } else {
+                wake.notify_one();
+                std::this_thread::yield();
+            }
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            // Another thread took this slot first.
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publish(Record* r, size_t length) {
+    static constexpr std::string_view ELLIPSIS = "...";
+    if (length > sizeof(r->text)) {
+        // Mark truncated messages.
+        length = sizeof(r->text);
+        ELLIPSIS.copy(r->text + length - ELLIPSIS.size(), ELLIPSIS.size());
+    }
+    r->length = uint16_t(length);
+    r->sequence.store(r->position + 1, std::memory_order_release);
+
+    if (mode == Mode::Sync) {
+        drain();
+    } else if (backlog() >= RING_SIZE / 2) {
+        wake.notify_one(); // Don't wait for the next flush interval.
+    }
+}
+
+bool Logger::internFormat(std::string_view key, std::string_view suffix, uint32_t& id) {
+    // Keys are mostly string literals, so a small per-thread cache indexed by
+    // their address saves taking the lock. The text is compared as well, since
+    // a buffer may be reused for a different message.
+    struct CacheEntry {
+        const char* suffix = nullptr;
+        std::string key;
+        uint32_t id = 0;
+        bool interned = false;
+    };
+    thread_local std::array<CacheEntry, 64> cache;
+    auto& entry = cache[(uintptr_t(key.data()) / 8 + uintptr_t(suffix.data())) % cache.size()];
+    if (entry.suffix == suffix.data() && entry.key == key) {
+        id = entry.id;
+        return entry.interned;
+    }
+
+    std::string text;
+    text.reserve(key.size() + suffix.size());
+    for (char c : key) {
+        text += c;
+        if (c == '{' || c == '}') text += c; // Escaped, as in std::format.
+    }
+    text += suffix;
+
+    std::lock_guard lock(formatMutex);
+    auto intern = [this](std::string&& text) {
+        auto [it, added] = formatIds.try_emplace(std::move(text), uint32_t(formatIds.size()));
+        if (added) pendingFormats.emplace_back(it->second, it->first);
+        return it->second;
+    };
+    bool interned = formatIds.contains(text) || formatIds.size() < MAX_FORMATS;
+    id = interned ? intern(std::move(text)) : intern("{}" + std::string(suffix));
+    entry = {suffix.data(), std::string(key), id, interned};
+    return interned;
+}
+
+void Logger::drain() {
+    std::lock_guard lock(drainMutex);
+    bool binary = sink == Sink::Binary;
+    auto appendLine = [this](int64_t time, LogLevel level, std::string_view text) {
+        std::chrono::system_clock::time_point tp {std::chrono::system_clock::duration(time)};
+        std::format_to(std::back_inserter(drainBuffer), "{:%Y-%m-%d %H:%M:%S} {} {}\n",
+                       tp, LEVEL_TAGS[std::min<size_t>(size_t(level), std::size(LEVEL_TAGS) - 1)], text);
+    };
+    auto appendEvent = [this](const Record& r) {
+        appendBytes(drainBuffer, TraceTag::Event);
+        appendBytes(drainBuffer, r.time);
+        appendBytes(drainBuffer, r.level);
+        appendBytes(drainBuffer, r.formatId);
+        appendBytes(drainBuffer, r.length);
+        drainBuffer.append(r.text, r.length);
+    };
+
+    drainBuffer.clear();
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Record& r = ring[pos & (RING_SIZE - 1)];
+        if (r.sequence.load(std::memory_order_acquire) != pos + 1) break; // Not published yet.
+        if (binary) {
+            appendEvent(r);
+        } else {
+            appendLine(r.time, r.level, {r.text, r.length});
+        }
+        r.sequence.store(pos + RING_SIZE, std::memory_order_release);
+        dequeuePos.store(++pos, std::memory_order_relaxed);
+    }
+    if (size_t lost = dropped.exchange(0, std::memory_order_relaxed)) {
+        if (binary) {
+            appendBytes(drainBuffer, TraceTag::Dropped);
+            appendBytes(drainBuffer, steadyNanoseconds());
+            appendBytes(drainBuffer, uint64_t(lost));
+        } else {
+            appendLine(std::chrono::system_clock::now().time_since_epoch().count(), LogLevel::Warning,
+                       std::format("{} log messages dropped: the queue was full", lost));
+        }
+    }
+
+    if (binary) {
+        // Taken after the events, so that every format they use is included;
+        // written before them, so that the decoder knows it in time.
+        std::vector<std::pair<uint32_t, std::string>> formats;
+        {
+            std::lock_guard formatLock(formatMutex);
+            formats.swap(pendingFormats);
+        }
+        std::string definitions;
+        for (const auto& [id, text] : formats) {
+            uint16_t length = uint16_t(std::min<size_t>(text.size(), UINT16_MAX));
+            appendBytes(definitions, TraceTag::Format);
+            appendBytes(definitions, id);
+            appendBytes(definitions, length);
+            definitions.append(text, 0, length);
+        }
+        logFile.write(definitions.data(), std::streamsize(definitions.size()));
+    }
+
+    // One write and one flush per batch.
+    if (!drainBuffer.empty()) {
+        logFile.write(drainBuffer.data(), std::streamsize(drainBuffer.size()));
+        logFile.flush();
+    }
+}
+
+void Logger::log(LogLevel level, std::string_view message) {
+    write(level, message, "");
 }
 
 // Specialization for std::string to add quotes.
-void Logger::log(const std::string& key, const std::string& value) {
-    log(std::format("{}: \"{}\"", key, value));
+void Logger::log(LogLevel level, std::string_view key, const std::string& value) {
+    write(level, key, ": \"{}\"", value);
 }
 
 // Specialization for TStringView.
-void Logger::log(const std::string& key, const TStringView& value) {
-    log(key, std::string(value.data(), value.size()));
+void Logger::log(LogLevel level, std::string_view key, const TStringView& value) {
+    write(level, key, ": \"{}\"", std::string_view(value.data(), value.size()));
 }
 
 // Specialization for bool.
-void Logger::log(const std::string& key, bool value) {
-    log(std::format("{}: {}", key, value ? "True" : "False"));
+void Logger::log(LogLevel level, std::string_view key, bool value) {
+    write(level, key, ": {}", value ? "True" : "False");
 }
 
 // Specialization for pointers.
-void Logger::log(const std::string& key, const void* ptr) {
-    log(std::format("{}: {}", key, ptr));
+void Logger::log(LogLevel level, std::string_view key, const void* ptr) {
+    write(level, key, ": {}", ptr);
 }
 
 // Specialization for TRect.
-void Logger::log(const std::string& key, const TRect& r) {
-    log(std::format("{}: TRect(A=({}, {}), B=({}, {}), Size=({}, {}))",
-        key, r.a.x, r.a.y, r.b.x, r.b.y, r.b.x - r.a.x, r.b.y - r.a.y));
+void Logger::log(LogLevel level, std::string_view key, const TRect& r) {
+    write(level, key, ": TRect(A=({}, {}), B=({}, {}), Size=({}, {}))",
+        r.a.x, r.a.y, r.b.x, r.b.y, r.b.x - r.a.x, r.b.y - r.a.y);
 }
 
 // Specialization for TPoint.
-void Logger::log(const std::string& key, const TPoint& p) {
-    log(std::format("{}: TPoint(X={}, Y={})", key, p.x, p.y));
+void Logger::log(LogLevel level, std::string_view key, const TPoint& p) {
+    write(level, key, ": TPoint(X={}, Y={})", p.x, p.y);
 }
@@ -83,17 +83,90 @@
 #ifndef DNLOGGER_H
 #define DNLOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <format>
+#include <memory>
+#include <mutex>
 #include <source_location>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
 #include <tvision/tv.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dntrace.h"
 
 // Forward-declarations of Turbo Vision types used in logging functions.
 // This avoids pulling in their full definitions into this header.
 class TPoint;
 class TRect;
 
+// Severity of a log message.
+enum class LogLevel : uint8_t { Debug, Info, Warning, Error, Off };
+
+// Messages below this level are compiled out entirely; it is set by CMake
+// (DN4L_LOG_LEVEL, the numeric value of a LogLevel).
+#ifndef DN4L_LOG_LEVEL
+#define DN4L_LOG_LEVEL 0
+#endif
+inline constexpr LogLevel COMPILED_LOG_LEVEL = LogLevel(DN4L_LOG_LEVEL);
+
+// The way to log: DNLOG_INFO("Found items", count). Below the compiled-in level
+// a call is discarded at compile time, and below the runtime level (see
+// Logger::setLevel()) it costs one comparison; either way its arguments are
+// not evaluated.
+#define DNLOG(level, ...)                                                      \
+    do {                                                                       \
+        if constexpr ((level) >= COMPILED_LOG_LEVEL) {                         \
+            if (Logger::isEnabled(level)) {                                    \
+                Logger::getInstance().log((level), __VA_ARGS__);               \
+            }                                                                  \
+        }                                                                      \
+    } while (false)
+#define DNLOG_DEBUG(...) DNLOG(LogLevel::Debug, __VA_ARGS__)
+#define DNLOG_INFO(...) DNLOG(LogLevel::Info, __VA_ARGS__)
+#define DNLOG_WARNING(...) DNLOG(LogLevel::Warning, __VA_ARGS__)
+#define DNLOG_ERROR(...) DNLOG(LogLevel::Error, __VA_ARGS__)
+
+// What follows the key of a message with several values, as in ": 3, \"a\"";
+// text is quoted, as a single value of it is. See Logger::log().
+template <typename... Args>
+struct LogListFormat {
+    template <typename T>
+    static constexpr bool isText = std::is_convertible_v<const T&, std::string_view>;
+    // Each value takes ": " or ", " and its {}.
+    static constexpr size_t SIZE = ((isText<Args> ? 6 : 4) + ...) + 1;
+
+    char text[SIZE] {};
+
+    consteval LogListFormat() {
+        size_t n = 0;
+        auto append = [&](std::string_view piece) {
+            for (char c : piece) text[n++] = c;
+        };
+        append(":");
+        ((append(n == 1 ? " " : ", "), append(isText<Args> ? "\"{}\"" : "{}")), ...);
+    }
+};
+
+template <typename... Args>
+inline constexpr LogListFormat<Args...> LOG_LIST_FORMAT {};
+
+// Messages are formatted by the caller straight into a fixed-size record of a
+// lock-free ring buffer, without allocating. In the default asynchronous mode a
+// writer thread takes them from there and writes them out in batches, so that
+// logging costs the caller neither a system call nor a flush.
+//
+// The binary sink skips formatting altogether: records hold the id of the
+// message's format string and the raw arguments (see dntrace.h), and
+// dn4l_tracedump turns them into text or JSON later.
 class Logger {
 public:
     // Meyers' Singleton: The single instance is created on first access.
@@ -109,41 +182,175 @@ public:
     Logger(Logger&&) = delete;
     Logger& operator=(Logger&&) = delete;
 
+    enum class Mode {
+        Sync,  // Every message is written and flushed by the caller.
+        Async, // Messages are queued and written by a background thread.
+    };
+
+    enum class Sink {
+        Text,   // Readable lines in dn4l.log.
+        Binary, // Compact records in dn4l.trace.
+    };
+
+    // What an asynchronous log() does when the queue is full.
+    enum class OverflowPolicy {
+        Drop,  // Discard the message; the number of lost messages is logged later.
+        Block, // Wait for the writer thread to make room.
+    };
+
 public:
     ~Logger();
 
-    // Generic log function for simple string messages.
-    void log(const std::string& message);
+    // Messages below 'level' are ignored at runtime.
+    static void setLevel(LogLevel level) { threshold.store(level, std::memory_order_relaxed); }
+    static bool isEnabled(LogLevel level) { return level >= threshold.load(std::memory_order_relaxed); }
+    // Accepts "debug", "info", "warning", "error" and "off".
+    static bool parseLevel(std::string_view name, LogLevel& level);
+
+    // Meant to be called at startup, before other threads log.
+    void setMode(Mode mode);
+    // Only has an effect before the first message, which opens the file.
+    void setSink(Sink aSink) { sink = aSink; }
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy = policy; }
+    // Writes out everything queued so far.
+    void flush();
+
+    // Generic log function for simple string messages. These are normally
+    // called through the DNLOG macros, which check the level first.
+    void log(LogLevel level, std::string_view message);
 
     // Overloaded log functions for key-value pairs of various types.
     // C++20's std::format is used for type-safe and efficient formatting.
     template <typename T>
-    void log(const std::string& key, const T& value) {
-        if (!initialized) openLogFile();
-        if (initialized) {
-            logFile << getTimestamp() << ": " << std::format("{}: {}", key, value) << std::endl;
-        }
+    void log(LogLevel level, std::string_view key, const T& value) {
+        write(level, key, ": {}", value);
     }
 
     // Specializations for types that don't have a default std::formatter.
-    void log(const std::string& key, const std::string& value);
-    void log(const std::string& key, const TStringView& value);
-    void log(const std::string& key, bool value);
-    void log(const std::string& key, const void* ptr);
-    void log(const std::string& key, const TRect& r);
-    void log(const std::string& key, const TPoint& p);
+    void log(LogLevel level, std::string_view key, const std::string& value);
+    void log(LogLevel level, std::string_view key, const TStringView& value);
+    void log(LogLevel level, std::string_view key, bool value);
+    void log(LogLevel level, std::string_view key, const void* ptr);
+    void log(LogLevel level, std::string_view key, const TRect& r);
+    void log(LogLevel level, std::string_view key, const TPoint& p);
+
+    // A key with several values: DNLOG_INFO("Queued transfer job", job, verb, what)
+    // writes "Queued transfer job: 3, \"Copy\", \"2 files\"". As with one, the
+    // key stays the message's format and the values its arguments.
+    template <typename T, typename U, typename... Rest>
+    void log(LogLevel level, std::string_view key, const T& first, const U& second, const Rest&... rest) {
+        write(level, key, LOG_LIST_FORMAT<T, U, Rest...>.text, first, second, rest...);
+    }
 
 private:
     // Private constructor to prevent direct instantiation.
     explicit Logger(const std::string& filePath);
 
+    // One slot of the ring buffer. 'sequence' tells producers and the consumer
+    // whose turn it is (Dmitry Vyukov's bounded queue).
+    static constexpr size_t RECORD_SIZE = 256;
+    static constexpr size_t RING_SIZE = 4096; // Records; a power of two.
+    struct alignas(64) Record {
+        std::atomic<size_t> sequence;
+        size_t position;
+        int64_t time;      // system_clock ticks; steady_clock nanoseconds for the binary sink.
+        uint32_t formatId; // Binary sink only.
+        uint16_t length;
+        LogLevel level;
+        char text[RECORD_SIZE - 2 * sizeof(size_t) - sizeof(int64_t) - sizeof(uint32_t) - sizeof(uint16_t) - sizeof(LogLevel)];
+    };
+
+    // The part of a message after its key, as a std::format string and as the
+    // text that goes into the binary sink's format records.
+    template <typename... Args>
+    struct Format {
+        std::format_string<Args...> format;
+        std::string_view text;
+        template <size_t N>
+        consteval Format(const char (&s)[N]) : format(s), text(s, N - 1) {}
+    };
+
+    template <typename... Args>
+    void write(LogLevel level, std::string_view key, Format<std::type_identity_t<const Args&>...> fmt, const Args&... args) {
+        Record* r = acquire();
+        if (!r) return;
+        r->level = level;
+        size_t length;
+        if (sink == Sink::Binary) {
+            TraceArgWriter w(r->text, sizeof(r->text));
+            if (!internFormat(key, fmt.text, r->formatId)) {
+                w.put(key); // Too many formats already; the key goes along as an argument.
+            }
+            (putTraceArg(w, args), ...);
+            length = w.size();
+        } else {
+            auto head = std::format_to_n(r->text, sizeof(r->text), "{}", key);
+            length = size_t(head.size);
+            if (length < sizeof(r->text)) {
+                length += size_t(std::format_to_n(head.out, sizeof(r->text) - length, fmt.format, args...).size);
+            }
+        }
+        publish(r, length);
+    }
+
+    template <typename T>
+    static void putTraceArg(TraceArgWriter& w, const T& value) {
+        if constexpr (requires { w.put(value); }) {
+            w.put(value);
+        } else {
+            // Anything else std::format knows is stored as text.
+            char buffer[128];
+            auto result = std::format_to_n(buffer, sizeof(buffer), "{}", value);
+            w.put(std::string_view(buffer, std::min(size_t(result.size), sizeof(buffer))));
+        }
+    }
+
+    // Finds or assigns the id of the format "<key><suffix>". Returns false if
+    // there are too many formats already, in which case 'id' refers to
+    // "{}<suffix>" and the key has to be passed as an argument.
+    bool internFormat(std::string_view key, std::string_view suffix, uint32_t& id);
+
+    // Claims a free record; nullptr if the message is to be dropped.
+    Record* acquire();
+    // Hands a record filled with 'length' bytes of text over to the writer.
+    void publish(Record* r, size_t length);
+    // Writes out all published records. Only one thread drains at a time.
+    void drain();
+    void writerLoop(std::stop_token stop);
+    void startWriter();
+    void stopWriter();
+    size_t backlog() const { return enqueuePos.load(std::memory_order_relaxed) - dequeuePos.load(std::memory_order_relaxed); }
+
     void openLogFile();
     std::string getTimestamp();
 
+    inline static std::atomic<LogLevel> threshold {LogLevel::Debug};
+
     std::ofstream logFile;
     bool initialized;
     std::string logFilePath;
+    std::string traceFilePath;
+    std::atomic<Sink> sink {Sink::Text};
     bool openFileError;
+    std::once_flag openFlag;
+
+    std::atomic<Mode> mode {Mode::Async};
+    std::atomic<OverflowPolicy> overflowPolicy {OverflowPolicy::Drop};
+    std::unique_ptr<Record[]> ring;
+    alignas(64) std::atomic<size_t> enqueuePos {0};
+    alignas(64) std::atomic<size_t> dequeuePos {0};
+    std::atomic<size_t> dropped {0};
+
+    std::mutex drainMutex;
+    std::string drainBuffer; // Guarded by drainMutex.
+    // The binary sink's format strings, and those not written out yet.
+    std::mutex formatMutex;
+    std::unordered_map<std::string, uint32_t> formatIds;
+    std::vector<std::pair<uint32_t, std::string>> pendingFormats;
+
+    std::mutex wakeMutex;
+    std::condition_variable_any wake;
+    std::jthread writer;
 };
 
 #endif // DNLOGGER_H
@@ -0,0 +1,192 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "dnprof.h"
+#include "dnlogger.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <format>
+
+namespace {
+
+constexpr std::string_view PROBE_NAMES[] = {
+    "event", "draw", "line", "load", "enumerate", "sort batch", "merge", "sort",
+    "filter",
+};
+static_assert(std::size(PROBE_NAMES) == size_t(Probe::Count));
+
+}
+
+int LatencyHistogram::bucketOf(uint64_t ns) {
+    // The first SUB_BUCKETS values have a bucket each; above that, every power
+    // of two is split into SUB_BUCKETS buckets.
+    if (ns < SUB_BUCKETS) return int(ns);
+    int shift = std::bit_width(ns) - 1 - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + int((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::valueOf(int bucket) {
+    if (bucket < SUB_BUCKETS) return uint64_t(bucket);
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t low = uint64_t(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return low + (uint64_t(1) << shift) / 2;
+}
+
+void LatencyHistogram::record(uint64_t ns) noexcept {
+    buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t seen = max.load(std::memory_order_relaxed);
+    while (ns > seen && !max.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const {
+    // Other threads may record meanwhile; the result is only approximate then.
+    Summary s;
+    std::array<uint32_t, BUCKETS> snapshot;
+    for (int i = 0; i < BUCKETS; ++i) {
+        snapshot[i] = buckets[i].load(std::memory_order_relaxed);
+        s.count += snapshot[i];
+    }
+    if (s.count == 0) return s;
+    s.max = max.load(std::memory_order_relaxed);
+
+    uint64_t p50Rank = (s.count + 1) / 2;
+    uint64_t p99Rank = s.count - s.count / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS && seen < p99Rank; ++i) {
+        uint64_t before = seen;
+        seen += snapshot[i];
+        if (before < p50Rank && seen >= p50Rank) s.p50 = std::min(valueOf(i), s.max);
+        if (seen >= p99Rank) s.p99 = std::min(valueOf(i), s.max);
+    }
+    return s;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& b : buckets) {
+        b.store(0, std::memory_order_relaxed);
+    }
+    max.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::reset() {
+    for (auto& h : histograms) {
+        h.reset();
+    }
+}
+
+void Profiler::report() const {
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        auto s = histograms[i].summarize();
+        if (s.count == 0) continue;
+        char p50[16], p99[16], max[16], line[128];
+        auto end = std::format_to_n(line, sizeof(line), "{} calls, p50 {}, p99 {}, max {}", s.count,
+                                    formatDuration(s.p50, p50), formatDuration(s.p99, p99),
+                                    formatDuration(s.max, max)).out;
+        char key[32];
+        auto keyEnd = std::format_to_n(key, sizeof(key), "Timing {}", PROBE_NAMES[i]).out;
+        DNLOG_INFO(std::string_view(key, keyEnd - key), std::string_view(line, end - line));
+    }
+}
+
+std::string_view Profiler::name(Probe probe) {
+    return PROBE_NAMES[size_t(probe)];
+}
+
+std::string_view Profiler::formatDuration(uint64_t ns, std::span<char> buf) {
+    static constexpr struct {
+        uint64_t scale;
+        std::string_view unit;
+    } UNITS[] = {{1, "ns"}, {1000, "us"}, {1000000, "ms"}, {1000000000, "s"}};
+
+    size_t u = 0;
+    while (u + 1 < std::size(UNITS) && ns >= UNITS[u + 1].scale) ++u;
+    double value = double(ns) / double(UNITS[u].scale);
+    // One decimal while it is short, e.g. "12.5us" but "125us".
+    int precision = u > 0 && value < 100 ? 1 : 0;
+    size_t room = buf.size() - std::min(buf.size(), UNITS[u].unit.size());
+    auto [end, ec] = std::to_chars(buf.data(), buf.data() + room, value, std::chars_format::fixed, precision);
+    if (ec != std::errc()) return {};
+    end = std::copy(UNITS[u].unit.begin(), UNITS[u].unit.end(), end);
+    return {buf.data(), size_t(end - buf.data())};
+}
@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef DNPROF_H
+#define DNPROF_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Points in the code whose running times are collected.
+enum class Probe : uint8_t {
+    HandleEvent,   // TDNApp::handleEvent(), including the redraws it causes.
+    PanelDraw,     // TFilePanel::draw().
+    DrawLine,      // One line of a panel.
+    LoadDirectory, // TFilePanel::loadDirectory(), up to the scan being started.
+    Enumerate,     // Reading one batch of directory entries, on the loader thread.
+    SortBatch,     // Sorting a batch before it is handed to the panel, on the loader thread.
+    MergeBatch,    // Merging a batch into the panel's listing.
+    SortList,      // Re-sorting a whole listing.
+    Filter,        // Narrowing a listing down to the names that pass a filter.
+    Count
+};
+
+// A histogram of durations with buckets that grow with the value, so that it
+// covers nanoseconds to hours in a fixed amount of memory while keeping the
+// relative error of a percentile under 1/16. Recording is one or two relaxed
+// atomic operations and is safe from any thread.
+class LatencyHistogram {
+public:
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t p50 = 0; // Nanoseconds.
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+    void record(uint64_t ns) noexcept;
+    Summary summarize() const;
+    void reset();
+
+private:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketOf(uint64_t ns);
+    // A value in the middle of the bucket, as its estimate.
+    static uint64_t valueOf(int bucket);
+
+    std::array<std::atomic<uint32_t>, BUCKETS> buckets {};
+    std::atomic<uint64_t> max {0};
+};
+
+// Collects the durations measured by ScopedTimer, one histogram per Probe.
+// They are shown by TProfileView and logged by report() when the program ends.
+class Profiler {
+public:
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void record(Probe probe, uint64_t ns) noexcept { histograms[size_t(probe)].record(ns); }
+    LatencyHistogram::Summary summary(Probe probe) const { return histograms[size_t(probe)].summarize(); }
+    void reset();
+
+    // Logs the percentiles of every probe that has fired.
+    void report() const;
+
+    static std::string_view name(Probe probe);
+    // Writes 'ns' with a unit that keeps it short, e.g. "850ns", "12.5us" or
+    // "3.2s", and returns it. 'buf' should hold at least 8 characters.
+    static std::string_view formatDuration(uint64_t ns, std::span<char> buf);
+
+private:
+    Profiler() = default;
+
+    std::array<LatencyHistogram, size_t(Probe::Count)> histograms;
+};
+
+// Measures the time until the end of the scope. It reads the clock twice, so
+// it is cheap enough to stay compiled in, but not to go into inner loops.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Probe aProbe) noexcept : probe(aProbe), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::getInstance().record(probe, uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Probe probe;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // DNPROF_H
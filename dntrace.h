@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef DNTRACE_H
+#define DNTRACE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// The binary trace format written by Logger's binary sink and decoded by
+// dn4l_tracedump. A trace is a sequence of records, each starting with a
+// TraceTag byte; numbers are in native byte order.
+//
+//   Session:  magic[8], steady clock ns (i64), system clock ns (i64) at the start
+//   Format:   id (u32), length (u16), text with a {} for every argument
+//   Event:    steady clock ns (i64), level (u8), format id (u32), length (u16), arguments
+//   Dropped:  steady clock ns (i64), number of messages lost (u64)
+//
+// Each argument is a TraceArg byte followed by its value; strings are stored
+// as a u16 length and the bytes. A Format record always precedes the first
+// Event using it; ids are only unique within a session.
+
+inline constexpr char TRACE_MAGIC[8] = {'D', 'N', '4', 'L', 'T', 'R', 'C', '1'};
+
+enum class TraceTag : uint8_t { Session, Format, Event, Dropped };
+enum class TraceArg : uint8_t { Int = 1, UInt, Double, Bool, String, Pointer };
+
+// Encodes event arguments into a fixed-size buffer. Arguments that don't fit
+// are left out, so the decoder shows fewer values than placeholders.
+class TraceArgWriter {
+public:
+    TraceArgWriter(char* buffer, size_t capacity) : begin(buffer), pos(buffer), end(buffer + capacity) {}
+
+    size_t size() const { return size_t(pos - begin); }
+
+    void put(bool value) { putValue(TraceArg::Bool, uint8_t(value)); }
+    void put(std::string_view value) {
+        if (full || size_t(end - pos) < 3) {
+            full = true;
+            return;
+        }
+        uint16_t length = uint16_t(std::min<size_t>(value.size(), size_t(end - pos) - 3));
+        *pos++ = char(TraceArg::String);
+        std::memcpy(pos, &length, sizeof(length));
+        std::memcpy(pos + sizeof(length), value.data(), length);
+        pos += sizeof(length) + length;
+        full = length < value.size();
+    }
+    void put(const char* value) { put(std::string_view(value ? value : "(null)")); }
+    void put(const void* value) { putValue(TraceArg::Pointer, uint64_t(uintptr_t(value))); }
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void put(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            putValue(TraceArg::Double, double(value));
+        } else if constexpr (std::is_signed_v<T>) {
+            putValue(TraceArg::Int, int64_t(value));
+        } else {
+            putValue(TraceArg::UInt, uint64_t(value));
+        }
+    }
+
+private:
+    template <typename V>
+    void putValue(TraceArg type, V value) {
+        if (full || size_t(end - pos) < 1 + sizeof(V)) {
+            full = true;
+            return;
+        }
+        *pos++ = char(type);
+        std::memcpy(pos, &value, sizeof(V));
+        pos += sizeof(V);
+    }
+
+    char* begin;
+    char* pos;
+    char* end;
+    bool full = false;
+};
+
+#endif // DNTRACE_H
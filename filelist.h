@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef FILELIST_H
+#define FILELIST_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A type-safe enum to represent the kind of entry in the file list.
+enum class FileEntryType : uint8_t { File, Directory };
+
+// A packed record describing one entry of a listing. The name itself is not
+// stored here but in the string arena of the owning FileList, so an entry is
+// trivially copyable and a whole listing sits in two contiguous blocks.
+struct FileEntry {
+    uint32_t nameOffset;
+    uint16_t nameLength;
+    FileEntryType type;
+    bool hasStat;      // Whether the fields below have been filled in.
+    uint32_t mode;     // st_mode
+    bool hasTreeSize;  // A directory whose 'size' is the total of its tree, maybe partial.
+    uint64_t size;
+    int64_t mtime;     // Seconds since the epoch.
+};
+
+// The storage behind a panel listing: a flat table of FileEntry records plus a
+// single arena holding all the names. clear() keeps the capacity of both, so
+// reloading a directory of similar size performs no allocations at all.
+class FileList {
+public:
+    using iterator = std::vector<FileEntry>::iterator;
+    using const_iterator = std::vector<FileEntry>::const_iterator;
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    FileEntry& operator[](size_t i) { return entries[i]; }
+    const FileEntry& operator[](size_t i) const { return entries[i]; }
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+    // Views into the arena; they are invalidated by the next add()/append().
+    std::string_view name(const FileEntry& e) const { return {names.data() + e.nameOffset, e.nameLength}; }
+    std::string_view name(size_t i) const { return name(entries[i]); }
+
+    // The returned reference is valid until the next add()/append().
+    FileEntry& add(std::string_view name, FileEntryType type);
+    // Appends all entries of 'other', copying their names into this arena.
+    void append(const FileList& other);
+    void reserve(size_t entryCount, size_t nameBytes);
+    // Drops the entries past the first 'count'. Their names stay in the arena
+    // until the next clear() or compact().
+    void truncate(size_t count);
+    void clear();
+
+    // The size of the arena, and how much of it no entry's name is in: the
+    // names of entries dropped or overwritten since the last clear().
+    size_t nameBytes() const { return names.size(); }
+    size_t deadNameBytes() const;
+    // Copies the names still in use to a new arena, in the order of the
+    // entries. Every nameOffset changes; the entries stay where they are.
+    void compact();
+
+    // Bytes of heap memory held by the list.
+    size_t memoryUsage() const { return entries.capacity() * sizeof(FileEntry) + names.capacity(); }
+
+private:
+    std::vector<FileEntry> entries;
+    std::string names;
+};
+
+#endif // FILELIST_H
@@ -0,0 +1,229 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "filemask.h"
+
+namespace {
+
+// Extensions longer than this are matched as suffixes, so that looking one
+// up never needs more than a buffer on the stack.
+constexpr size_t MAX_EXTENSION_LENGTH = 15;
+
+char toLower(char c) {
+    return c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
+}
+
+// Whether 'name' equals 'lower', which is lowercase, ignoring ASCII case.
+bool equalsFolded(std::string_view name, std::string_view lower) {
+    if (name.size() != lower.size()) return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (toLower(name[i]) != lower[i]) return false;
+    }
+    return true;
+}
+
+bool containsFolded(std::string_view name, std::string_view lower) {
+    if (lower.empty()) return true;
+    for (size_t i = 0; i + lower.size() <= name.size(); ++i) {
+        if (toLower(name[i]) == lower.front() && equalsFolded(name.substr(i, lower.size()), lower)) return true;
+    }
+    return false;
+}
+
+// Matches with backtracking to the last '*' only, which is enough: a later
+// '*' can absorb anything an earlier one would have to.
+bool matchPattern(std::string_view pattern, std::string_view name) {
+    size_t p = 0, n = 0;
+    size_t starP = std::string_view::npos, starN = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == toLower(name[n]))) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starN = n;
+        } else if (starP != std::string_view::npos) {
+            p = starP + 1;
+            n = ++starN;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+}
+
+FileMask::FileMask(std::string_view masks) {
+    while (!masks.empty()) {
+        size_t end = masks.find_first_of(";,");
+        std::string_view mask = masks.substr(0, end);
+        masks.remove_prefix(end == std::string_view::npos ? masks.size() : end + 1);
+        while (!mask.empty() && mask.front() == ' ') mask.remove_prefix(1);
+        while (!mask.empty() && mask.back() == ' ') mask.remove_suffix(1);
+        if (mask.empty()) continue;
+        if (mask.front() == '-') {
+            mask.remove_prefix(1);
+            if (!mask.empty()) excluded.add(mask);
+        } else {
+            included.add(mask);
+        }
+    }
+}
+
+bool FileMask::matches(std::string_view name) const {
+    return (included.matchesAll() || included.matches(name)) && !excluded.matches(name);
+}
+
+void FileMask::PatternSet::add(std::string_view mask) {
+    if (mask == "*.*") mask = "*";
+    std::string pattern(mask);
+    for (char& c : pattern) c = toLower(c);
+
+    // What is left between a leading and a trailing '*'.
+    std::string_view body = pattern;
+    bool leadingStar = false, trailingStar = false;
+    while (!body.empty() && body.front() == '*') {
+        body.remove_prefix(1);
+        leadingStar = true;
+    }
+    while (!body.empty() && body.back() == '*') {
+        body.remove_suffix(1);
+        trailingStar = true;
+    }
+    if (body.empty()) {
+        if (leadingStar) all = true;
+        return;
+    }
+    if (body.find_first_of("*?") != std::string_view::npos) {
+        patterns.push_back({Kind::Wildcard, std::move(pattern)});
+    } else if (leadingStar && trailingStar) {
+        patterns.push_back({Kind::Infix, std::string(body)});
+    } else if (leadingStar && body.size() > 1 && body.size() - 1 <= MAX_EXTENSION_LENGTH
+               && body.front() == '.' && body.find('.', 1) == std::string_view::npos) {
+        // Ending with ".ext" is the same as having the extension "ext".
+        extensions.emplace(body.substr(1));
+    } else if (leadingStar) {
+        patterns.push_back({Kind::Suffix, std::string(body)});
+    } else if (trailingStar) {
+        patterns.push_back({Kind::Prefix, std::string(body)});
+    } else {
+        patterns.push_back({Kind::Name, std::string(body)});
+    }
+}
+
+bool FileMask::PatternSet::matches(std::string_view name) const {
+    if (all) return true;
+    if (!extensions.empty()) {
+        size_t dot = name.rfind('.');
+        if (dot != std::string_view::npos && name.size() - dot - 1 <= MAX_EXTENSION_LENGTH) {
+            char extension[MAX_EXTENSION_LENGTH];
+            size_t length = name.size() - dot - 1;
+            for (size_t i = 0; i < length; ++i) extension[i] = toLower(name[dot + 1 + i]);
+            if (extensions.contains(std::string_view(extension, length))) return true;
+        }
+    }
+    for (const auto& pattern : patterns) {
+        std::string_view text = pattern.text;
+        bool match = false;
+        switch (pattern.kind) {
+            case Kind::Name:
+                match = equalsFolded(name, text);
+                break;
+            case Kind::Prefix:
+                match = name.size() >= text.size() && equalsFolded(name.substr(0, text.size()), text);
+                break;
+            case Kind::Suffix:
+                match = name.size() >= text.size() && equalsFolded(name.substr(name.size() - text.size()), text);
+                break;
+            case Kind::Infix:
+                match = containsFolded(name, text);
+                break;
+            case Kind::Wildcard:
+                match = matchPattern(text, name);
+                break;
+        }
+        if (match) return true;
+    }
+    return false;
+}
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef FILEMASK_H
+#define FILEMASK_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// A list of wildcard patterns as Dos Navigator takes them, e.g.
+// "*.cpp;*.h;-*.bak". '*' matches any run of characters and '?' any one;
+// ASCII letters match in either case. As in DOS, "*.*" matches every name,
+// with a dot or not. Patterns starting with '-' exclude the names they match;
+// if there are only such patterns, every other name matches.
+//
+// The patterns are compiled when the mask is made: all "*.ext" patterns go
+// into one set of extensions that takes a single lookup, plain names,
+// prefixes ("abc*"), suffixes ("*abc") and infixes ("*abc*") are compared
+// directly, and only what is left goes through a general wildcard matcher.
+class FileMask {
+public:
+    // Empty, or only separators, matches everything.
+    explicit FileMask(std::string_view masks = {});
+
+    bool matches(std::string_view name) const;
+    bool matchesAll() const { return included.matchesAll() && excluded.empty(); }
+
+    // Whether 'text' is meant as a mask rather than as (part of) a name,
+    // i.e. has wildcards or separators in it.
+    static bool isMask(std::string_view text) { return text.find_first_of("*?;,") != std::string_view::npos; }
+
+private:
+    enum class Kind : uint8_t { Name, Prefix, Suffix, Infix, Wildcard };
+    struct Pattern {
+        Kind kind;
+        std::string text; // Lowercase, without the leading and trailing '*' its kind implies.
+    };
+    // Extensions are short, so FNV-1a is cheaper than std::hash here.
+    struct ExtensionHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : s) hash = (hash ^ uint8_t(c)) * 1099511628211ull;
+            return size_t(hash);
+        }
+    };
+
+    // The included or the excluded patterns.
+    class PatternSet {
+    public:
+        void add(std::string_view pattern);
+        bool matches(std::string_view name) const;
+        bool empty() const { return !all && extensions.empty() && patterns.empty(); }
+        bool matchesAll() const { return all || empty(); }
+
+    private:
+        bool all = false; // Has "*" or "*.*".
+        std::unordered_set<std::string, ExtensionHash, std::equal_to<>> extensions; // Lowercase, without the dot.
+        std::vector<Pattern> patterns;
+    };
+
+    PatternSet included;
+    PatternSet excluded;
+};
+
+#endif // FILEMASK_H
@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "filesort.h"
+
+#include <algorithm>
+#include <cwctype>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Below this many entries per thread, splitting the work doesn't pay off.
+constexpr size_t MIN_CHUNK_SIZE = 16384;
+
+// A compact, precomputed sort key. The full key lives in a separate arena;
+// its first bytes are kept inline so that most comparisons never touch it.
+struct SortKey {
+    uint64_t prefix;     // First 8 bytes of the key, big-endian, zero padded.
+    uint64_t extPrefix;  // Same for the extension part of the key.
+    uint64_t number;     // Size or mtime, arranged so that larger sorts first.
+    uint32_t keyOffset;
+    uint16_t keyLength;
+    uint16_t extOffset;  // Start of the extension within the key; keyLength if none.
+    uint32_t index;      // Position of the entry in the unsorted list.
+    uint8_t group;       // 0: "..", 1: directories, 2: files.
+};
+
+uint64_t loadPrefix(std::string_view s) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        v = (v << 8) | (i < s.size() ? (unsigned char) s[i] : 0);
+    }
+    return v;
+}
+
+void appendUtf8(std::string& out, char32_t c) {
+    if (c < 0x80) {
+        out += char(c);
+    } else if (c < 0x800) {
+        out += char(0xC0 | (c >> 6));
+        out += char(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        out += char(0xE0 | (c >> 12));
+        out += char(0x80 | ((c >> 6) & 0x3F));
+        out += char(0x80 | (c & 0x3F));
+    } else {
+        out += char(0xF0 | (c >> 18));
+        out += char(0x80 | ((c >> 12) & 0x3F));
+        out += char(0x80 | ((c >> 6) & 0x3F));
+        out += char(0x80 | (c & 0x3F));
+    }
+}
+
+// Appends the sort key of 'name' to 'out' and returns the position of the
+// extension within it (the key length if there is none).
+//
+// The key is built so that comparing keys byte by byte gives the natural,
+// case-insensitive order of the names:
+//  - ASCII letters are folded inline; other UTF-8 sequences are decoded and
+//    passed through towlower(). Invalid sequences are copied as they are.
+//  - A run of digits becomes '0', the count of its significant digits and then
+//    those digits, so that "9" < "10" and the run still sorts against other
+//    characters as its first digit would.
+size_t appendKey(std::string& out, std::string_view name) {
+    size_t start = out.size();
+    size_t ext = std::string_view::npos;
+    for (size_t i = 0; i < name.size();) {
+        unsigned char c = name[i];
+        if (c >= '0' && c <= '9') {
+            while (i < name.size() && name[i] == '0') ++i;
+            size_t sig = i;
+            while (i < name.size() && name[i] >= '0' && name[i] <= '9') ++i;
+            out += '0';
+            out += char(i - sig);
+            out.append(name.substr(sig, i - sig));
+            continue;
+        }
+        if (c < 0x80) {
+            // A leading dot (".bashrc") doesn't start an extension.
+            if (c == '.' && i > 0) ext = out.size() + 1 - start;
+            out += (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : char(c);
+            ++i;
+            continue;
+        }
+        size_t len = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 0;
+        char32_t cp = len == 4 ? (c & 0x07) : len == 3 ? (c & 0x0F) : (c & 0x1F);
+        bool valid = len != 0 && i + len <= name.size();
+        for (size_t k = 1; valid && k < len; ++k) {
+            unsigned char cc = name[i + k];
+            valid = (cc & 0xC0) == 0x80;
+            cp = (cp << 6) | (cc & 0x3F);
+        }
+        if (!valid) {
+            out += char(c);
+            ++i;
+            continue;
+        }
+        appendUtf8(out, char32_t(std::towlower(wint_t(cp))));
+        i += len;
+    }
+    return ext == std::string_view::npos ? out.size() - start : ext;
+}
+
+SortKey makeKey(const FileList& list, const FileEntry& e, uint32_t index, SortMode mode, std::string& arena) {
+    SortKey k;
+    std::string_view name = list.name(e);
+    k.keyOffset = uint32_t(arena.size());
+    k.extOffset = uint16_t(appendKey(arena, name));
+    k.keyLength = uint16_t(arena.size() - k.keyOffset);
+    std::string_view key(arena.data() + k.keyOffset, k.keyLength);
+    k.prefix = loadPrefix(key);
+    k.extPrefix = loadPrefix(key.substr(k.extOffset));
+    k.index = index;
+    k.group = (name == "..") ? 0 : (e.type == FileEntryType::Directory) ? 1 : 2;
+    k.number = 0;
+    if (mode == SortMode::Size) {
+        k.number = e.size;
+    } else if (mode == SortMode::Time) {
+        k.number = uint64_t(e.mtime) ^ (uint64_t(1) << 63); // Order-preserving for signed values.
+    }
+    return k;
+}
+
+// Returns <0, 0 or >0. Entries equal here are also compared by raw name.
+int compareKeys(const SortKey& a, const SortKey& b, const char* arena, SortMode mode) {
+    if (a.group != b.group) return a.group < b.group ? -1 : 1;
+    if (mode == SortMode::Unsorted) return 0;
+    if (a.number != b.number) return a.number > b.number ? -1 : 1;
+
+    std::string_view keyA(arena + a.keyOffset, a.keyLength), keyB(arena + b.keyOffset, b.keyLength);
+    if (mode == SortMode::Extension) {
+        if (a.extPrefix != b.extPrefix) return a.extPrefix < b.extPrefix ? -1 : 1;
+        if (int c = keyA.substr(a.extOffset).compare(keyB.substr(b.extOffset))) return c;
+    }
+    if (a.prefix != b.prefix) return a.prefix < b.prefix ? -1 : 1;
+    return keyA.compare(keyB);
+}
+
+// Sorts 'v' by splitting it into one chunk per thread, sorting the chunks
+// concurrently and merging them pairwise, also concurrently.
+template <typename T, typename Less>
+void parallelSort(std::vector<T>& v, Less less) {
+    size_t n = v.size();
+    size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), n / MIN_CHUNK_SIZE);
+    if (threads <= 1) {
+        std::sort(v.begin(), v.end(), less);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= threads; ++i) {
+        bounds.push_back(n * i / threads);
+    }
+    {
+        std::vector<std::jthread> workers;
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([&, i] { std::sort(v.begin() + bounds[i], v.begin() + bounds[i + 1], less); });
+        }
+    }
+
+    std::vector<T> tmp(n);
+    while (bounds.size() > 2) {
+        std::vector<size_t> merged;
+        {
+            std::vector<std::jthread> workers;
+            for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+                size_t lo = bounds[i], mid = bounds[i + 1];
+                size_t hi = (i + 2 < bounds.size()) ? bounds[i + 2] : mid;
+                merged.push_back(lo);
+                workers.emplace_back([&, lo, mid, hi] {
+                    std::merge(v.begin() + lo, v.begin() + mid, v.begin() + mid, v.begin() + hi, tmp.begin() + lo, less);
+                });
+            }
+        }
+        merged.push_back(n);
+        v.swap(tmp);
+        bounds.swap(merged);
+    }
+}
+
+}
+
+bool FileSorter::less(const FileList& list, const FileEntry& a, const FileEntry& b) const {
+    // Reused buffer; the UI and worker threads each get their own.
+    thread_local std::string arena;
+    arena.clear();
+    SortKey ka = makeKey(list, a, 0, sortMode, arena);
+    SortKey kb = makeKey(list, b, 1, sortMode, arena);
+    if (int c = compareKeys(ka, kb, arena.data(), sortMode)) return c < 0;
+    // Names that fold to the same key ("Makefile", "makefile") are ordered by
+    // their raw bytes, so that the order is total and sort() agrees with less().
+    return sortMode != SortMode::Unsorted && list.name(a) < list.name(b);
+}
+
+void FileSorter::sort(FileList& list) const {
+    if (sortMode == SortMode::Unsorted) {
+        // Only the grouping applies; keep the directory order within groups.
+        std::stable_sort(list.begin(), list.end(), lessFn(list));
+        return;
+    }
+
+    std::string arena;
+    std::vector<SortKey> keys;
+    keys.reserve(list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        keys.push_back(makeKey(list, list[i], uint32_t(i), sortMode, arena));
+    }
+
+    auto keyLess = [&](const SortKey& a, const SortKey& b) {
+        if (int c = compareKeys(a, b, arena.data(), sortMode)) return c < 0;
+        return list.name(a.index) < list.name(b.index);
+    };
+    if (keys.size() >= PARALLEL_THRESHOLD) {
+        parallelSort(keys, keyLess);
+    } else {
+        std::sort(keys.begin(), keys.end(), keyLess);
+    }
+
+    std::vector<FileEntry> sorted;
+    sorted.reserve(keys.size());
+    for (const auto& k : keys) {
+        sorted.push_back(list[k.index]);
+    }
+    std::copy(sorted.begin(), sorted.end(), list.begin());
+}
@@ -80,30 +80,186 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#define Uses_TProgram
+#define Uses_TDeskTop
 #include "flpanel.h"
+#include "dirread.h"
 #include "dnlogger.h"
+#include "dnprof.h"
+#include "search.h"
+#include "viewwnd.h"
 
 #include <algorithm>
+#include <bitset>
+#include <charconv>
+#include <cstdint>
+#include <ctime>
+#include <format>
 #include <system_error>
 #include <ranges> // For C++20 ranges algorithms
+#include <unordered_set>
 
-TFilePanel::TFilePanel(const TRect& bounds) : TGroup(bounds) {
-    Logger::getInstance().log("TFilePanel constructor starting...", bounds);
+namespace {
+
+// Column widths, in cells.
+constexpr int MIN_NAME_WIDTH = 8;
+constexpr int SIZE_COLUMN_WIDTH = 10;
+constexpr int DATE_COLUMN_WIDTH = 8; // dd-mm-yy
+constexpr int TIME_COLUMN_WIDTH = 5; // hh:mm
+constexpr char COLUMN_SEPARATOR = '\xB3';
+
+// The '*' on the numeric keypad, which tkeys.h has no name for.
+constexpr ushort GRAY_STAR = 0x372a;
+
+// The names of entries changed or removed stay in the listing's arena; it is
+// compacted once they take more room than the live ones, and at least this.
+constexpr size_t MIN_DEAD_NAME_BYTES = 64 << 10;
+
+void formatName(TDrawBuffer& b, int x, int width, std::string_view name, bool isDirectory, TColorAttr color) {
+    // The name is copied straight from the listing's arena; the directory
+    // brackets are separate cells, so nothing needs to be formatted.
+    if (isDirectory) {
+        static constexpr char DIR_PREFIX = '[';
+        static constexpr char DIR_SUFFIX = ']';
+        b.moveChar(x, DIR_PREFIX, color, 1);
+        int nameWidth = b.moveStr(x + 1, name, color, width - 1);
+        if (1 + nameWidth < width) b.moveChar(x + 1 + nameWidth, DIR_SUFFIX, color, 1);
+    } else {
+        b.moveStr(x, name, color, width);
+    }
+}
+
+// Writes the size column of 'e' into 'buf' and returns it; sizes that don't
+// fit are shown in KiB, MiB and so on.
+std::string_view formatSize(char (&buf)[SIZE_COLUMN_WIDTH + 1], const FileEntry& e, std::string_view name) {
+    if (e.type == FileEntryType::Directory && !e.hasTreeSize) return name == ".." ? "UP--DIR" : "SUB-DIR";
+    if (e.type == FileEntryType::File && !e.hasStat) return {};
+
+    static constexpr char UNITS[] = "KMGTPE";
+    uint64_t value = e.size;
+    int unit = -1;
+    while (value >= 10000000000ull) { // More than SIZE_COLUMN_WIDTH digits.
+        value >>= 10;
+        ++unit;
+    }
+    auto [end, ec] = std::to_chars(buf, buf + SIZE_COLUMN_WIDTH, value);
+    if (unit >= 0) {
+        // Leave room for the unit.
+        while (end - buf > SIZE_COLUMN_WIDTH - 1) {
+            value >>= 10;
+            ++unit;
+            end = std::to_chars(buf, buf + SIZE_COLUMN_WIDTH, value).ptr;
+        }
+        *end++ = UNITS[unit];
+    }
+    return {buf, size_t(end - buf)};
+}
+
+char foldCase(char c) {
+    return c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
+}
+
+bool startsWithIgnoringCase(std::string_view name, std::string_view prefix) {
+    if (name.size() < prefix.size()) return false;
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (foldCase(name[i]) != foldCase(prefix[i])) return false;
+    }
+    return true;
+}
+
+void put2Digits(char* p, int value) {
+    p[0] = char('0' + value / 10 % 10);
+    p[1] = char('0' + value % 10);
+}
+
+// Writes "dd-mm-yy hh:mm" into 'buf'; returns false if there is no time to show.
+bool formatDateTime(char (&buf)[DATE_COLUMN_WIDTH + 1 + TIME_COLUMN_WIDTH], const FileEntry& e) {
+    if (!e.hasStat) return false;
+    std::time_t t = std::time_t(e.mtime);
+    std::tm tm;
+#ifdef _WIN32
+    if (localtime_s(&tm, &t) != 0) return false;
+#else
+    if (!localtime_r(&t, &tm)) return false;
+#endif
+    put2Digits(buf, tm.tm_mday);
+    buf[2] = '-';
+    put2Digits(buf + 3, tm.tm_mon + 1);
+    buf[5] = '-';
+    put2Digits(buf + 6, tm.tm_year % 100);
+    buf[8] = ' ';
+    put2Digits(buf + 9, tm.tm_hour);
+    buf[11] = ':';
+    put2Digits(buf + 12, tm.tm_min);
+    return true;
+}
+
+// Renders one entry into the 'width' cells from 'x' on, which are already cleared.
+void formatEntry(TDrawBuffer& b, int x, int width, const FileList& list, const FileEntry& e,
+                 const PanelLayout& layout, TColorAttr color) {
+    std::string_view name = list.name(e);
+    int detailsWidth = (layout.showSize ? 1 + SIZE_COLUMN_WIDTH : 0) + (layout.showDateTime ? 2 + DATE_COLUMN_WIDTH + TIME_COLUMN_WIDTH : 0);
+    int nameWidth = width - detailsWidth;
+    formatName(b, x, nameWidth, name, e.type == FileEntryType::Directory, color);
+    x += nameWidth;
+
+    if (layout.showSize) {
+        char buf[SIZE_COLUMN_WIDTH + 1];
+        std::string_view size = formatSize(buf, e, name);
+        b.moveChar(x, COLUMN_SEPARATOR, color, 1);
+        b.moveStr(x + 1 + SIZE_COLUMN_WIDTH - int(size.size()), size, color);
+        x += 1 + SIZE_COLUMN_WIDTH;
+    }
+    if (layout.showDateTime) {
+        char buf[DATE_COLUMN_WIDTH + 1 + TIME_COLUMN_WIDTH];
+        b.moveChar(x, COLUMN_SEPARATOR, color, 1);
+        b.moveChar(x + 1 + DATE_COLUMN_WIDTH, COLUMN_SEPARATOR, color, 1);
+        if (formatDateTime(buf, e)) {
+            b.moveStr(x + 1, std::string_view(buf, DATE_COLUMN_WIDTH), color);
+            b.moveStr(x + 2 + DATE_COLUMN_WIDTH, std::string_view(buf + DATE_COLUMN_WIDTH + 1, TIME_COLUMN_WIDTH), color);
+        }
+    }
+}
+
+}
+
+PanelLayout PanelLayout::compute(PanelView view, int briefColumns, TPoint size) {
+    PanelLayout layout;
+    layout.view = view;
+    layout.width = std::max(size.x, 0);
+    if (view == PanelView::Brief) {
+        int fit = (layout.width + 1) / (MIN_NAME_WIDTH + 1);
+        layout.columns = std::clamp(briefColumns, 1, std::max(fit, 1));
+        layout.columnWidth = (layout.width - (layout.columns - 1)) / layout.columns;
+    } else {
+        // Details are dropped, the time first, when they would squeeze the names too much.
+        layout.columnWidth = layout.width;
+        layout.showDateTime = layout.width - (1 + SIZE_COLUMN_WIDTH) - (2 + DATE_COLUMN_WIDTH + TIME_COLUMN_WIDTH) >= MIN_NAME_WIDTH;
+        layout.showSize = layout.showDateTime || layout.width - (1 + SIZE_COLUMN_WIDTH) >= MIN_NAME_WIDTH;
+    }
+    return layout;
+}
+
+TFilePanel::TFilePanel(const TRect& bounds, DirectoryCache* aCache, DirSizeCache* sizeCache)
+    : TGroup(bounds), cache(aCache), fetcher([this](MetadataFetcher::Result& result) { onMetadataFetched(result); }),
+      sizer([this](DirectorySizer::Result& result) { onSizeCalculated(result); }, sizeCache) {
+    DNLOG_DEBUG("TFilePanel constructor starting...", bounds);
 
     // Standard options for a framed, clickable, and buffered view.
     options |= ofFramed | ofBuffered | ofFirstClick;
     growMode = gfGrowAll; // The panel will grow/shrink with its parent window.
     eventMask |= evKeyDown; // We want to receive keyboard events.
+    updateLayout();
 
     std::error_code ec;
     auto initialPath = std::filesystem::current_path(ec);
     if (ec) {
-        Logger::getInstance().log("TFilePanel: Failed to get current path", ec.message());
+        DNLOG_WARNING("TFilePanel: Failed to get current path", ec.message());
         initialPath = "."; // Fallback to current directory.
     }
     loadDirectory(initialPath);
 
-    Logger::getInstance().log("TFilePanel constructor finished.");
+    DNLOG_DEBUG("TFilePanel constructor finished.");
 }
 
 void TFilePanel::setState(ushort aState, Boolean enable) {
@@ -115,70 +271,707 @@ void TFilePanel::setState(ushort aState, Boolean enable) {
 }
 
 void TFilePanel::loadDirectory(const std::filesystem::path& path) {
-    Logger::getInstance().log("TFilePanel::loadDirectory", path.string());
+    ScopedTimer timer(Probe::LoadDirectory);
+    DNLOG_DEBUG("TFilePanel::loadDirectory", path.string());
 
-    fileList.clear(); // unique_ptr destructors are called automatically.
-    currentPath = std::filesystem::absolute(path);
-    currentPath.make_preferred(); // Use native path separators (e.g., '\' on Windows).
+    std::filesystem::path newPath = std::filesystem::absolute(path);
+    newPath.make_preferred(); // Use native path separators (e.g., '\' on Windows).
+    if (newPath != currentPath) {
+        // A quick search or filter only survives a reload of the same directory.
+        typeAhead = TypeAhead::None;
+        quickSearchText.clear();
+        filterText.clear();
+    }
+    fileList.clear(); // Keeps the capacity for the new listing.
+    selection.clear();
+    listChanged();
+    pendingFocusName.clear();
+    deferredChanges.clear();
+    currentPath = std::move(newPath);
+    updateLayout();
+    fetcher.reset(currentPath);
+    sizer.cancel();
+    metadataRequested.clear();
+    bulkTotal = bulkDone = 0;
 
     // Add a ".." entry to navigate to the parent directory, unless we are at the root.
     if (currentPath.has_parent_path()) {
-        fileList.push_back(std::make_unique<FileEntry>("..", FileEntryType::Directory));
+        fileList.add("..", FileEntryType::Directory);
     }
+    setFocusedIndex(0); // Focus the first item in the new list.
 
-    std::vector<std::unique_ptr<FileEntry>> dirs;
-    std::vector<std::unique_ptr<FileEntry>> files;
+    // Start watching before scanning so that no change slips through in between.
+    if (!watcher.start(currentPath, [this](DirectoryChanges& changes) { onDirectoryChanged(changes); })) {
+        DNLOG_WARNING("TFilePanel: Cannot watch directory for changes", currentPath.string());
+    }
 
+    // Taken after the watcher started, so that any later change is either
+    // reported by it or makes the cached listing stale.
     std::error_code ec;
-    for (const auto& entry : std::filesystem::directory_iterator(currentPath, ec)) {
-        if (entry.is_directory(ec)) {
-            dirs.push_back(std::make_unique<FileEntry>(entry.path().filename(), FileEntryType::Directory));
-        } else if (entry.is_regular_file(ec)) {
-            files.push_back(std::make_unique<FileEntry>(entry.path().filename(), FileEntryType::File));
+    listingMtime = std::filesystem::last_write_time(currentPath, ec);
+    listingMtimeValid = !ec;
+    listingComplete = false;
+    if (loadFromCache()) return;
+
+    // The rest of the list is filled in by onBatchLoaded() as the worker thread
+    // streams entries back, so a huge or slow directory doesn't block the UI.
+    // The scan only reads names and types; orders that need more are reached
+    // by applySortOrder() once it is done.
+    listSorter = sorter.needsMetadata() ? FileSorter(SortMode::Name) : sorter;
+    loader.start(currentPath, listSorter,
+                 [this](DirectoryLoader::Batch& batch) { onBatchLoaded(batch); },
+                 [this](std::error_code ec) { onLoadFinished(ec); });
+}
+
+bool TFilePanel::loadFromCache() {
+    if (!cache || !listingMtimeValid) return false;
+
+    SortMode cachedMode;
+    if (!cache->get(currentPath, listingMtime, fileList, cachedMode)) {
+        DNLOG_DEBUG("TFilePanel: Listing cache miss", currentPath.string());
+        return false;
+    }
+    if (cachedMode != sorter.mode() && sorter.mode() == SortMode::Unsorted) {
+        // The unsorted order is the order in which the directory is read.
+        fileList.clear();
+        return false;
+    }
+    DNLOG_DEBUG("TFilePanel: Listing cache hit", currentPath.string());
+    listingComplete = true;
+    if (FileSorter(cachedMode).needsMetadata()) {
+        // The cache doesn't keep the sizes and times this order came from;
+        // applySortOrder() reads them again and sorts.
+        cachedMode = SortMode::Name;
+        FileSorter(cachedMode).sort(fileList);
+    }
+    listSorter = FileSorter(cachedMode);
+    listChanged();
+    setFocusedIndex(0);
+    applySortOrder();
+    return true;
+}
+
+void TFilePanel::storeInCache() {
+    // Only complete listings; changes applied from the watcher since the load
+    // have changed the directory's mtime, so such listings simply won't match.
+    if (cache && listingMtimeValid && listingComplete) {
+        cache->put(currentPath, fileList, listSorter.mode(), listingMtime);
+    }
+}
+
+void TFilePanel::onBatchLoaded(DirectoryLoader::Batch& batch) {
+    ScopedTimer timer(Probe::MergeBatch);
+    size_t sortedSize = fileList.size();
+    selection.save(fileList);
+    fileList.append(batch);
+
+    // The batch arrives sorted, so merging it into the sorted list is linear.
+    // Entries have no identity of their own, so the new position of the focused
+    // entry is worked out from the sorted ranges before merging them:
+    // it moves down by the number of new entries that sort before it.
+    auto less = listSorter.lessFn(fileList);
+    auto mid = fileList.begin() + sortedSize;
+    size_t newIndex = focusedItemIndex;
+    size_t focusRow = rowOf(focusedItemIndex);
+    focusRow -= std::min(topItemIndex, focusRow);
+    if (focusedItemIndex < sortedSize) {
+        newIndex += std::lower_bound(mid, fileList.end(), fileList[focusedItemIndex], less) - mid;
+    }
+    if (!pendingFocusName.empty()) {
+        auto it = std::find_if(mid, fileList.end(), [&](const FileEntry& e) {
+            return fileList.name(e) == pendingFocusName;
+        });
+        if (it != fileList.end()) {
+            newIndex = (it - mid) + (std::upper_bound(fileList.begin(), mid, *it, less) - fileList.begin());
+            pendingFocusName.clear();
         }
     }
+    std::inplace_merge(fileList.begin(), mid, fileList.end(), less);
+    selection.restore(fileList);
+    listChanged();
+    if (focusedItemIndex < sortedSize) {
+        // Scroll along with the focused entry so that it stays on the same row.
+        size_t newRow = rowOf(newIndex);
+        topItemIndex = newRow - std::min(focusRow, newRow);
+    }
+    setFocusedIndex(newIndex);
+}
 
+void TFilePanel::onLoadFinished(std::error_code ec) {
     if (ec) {
-        Logger::getInstance().log("TFilePanel: Error iterating directory", ec.message());
+        DNLOG_WARNING("TFilePanel: Error iterating directory", ec.message());
+    }
+    listingComplete = !ec;
+    DNLOG_DEBUG("TFilePanel: Found items", fileList.size());
+    finishLoading();
+}
+
+void TFilePanel::finishLoading() {
+    for (auto& changes : deferredChanges) {
+        applyChanges(changes);
     }
+    deferredChanges.clear();
+    applySortOrder();
+    if (!pendingFocusName.empty()) {
+        focusEntry(pendingFocusName);
+        pendingFocusName.clear();
+    }
+}
 
-    // Sort directories and files alphabetically using C++20 ranges and a projection.
-    // A projection extracts a "key" from each object for comparison.
-    auto pathProjection = [](const auto& entry) -> const auto& { return entry->path; };
-    std::ranges::sort(dirs, {}, pathProjection);
-    std::ranges::sort(files, {}, pathProjection);
+void TFilePanel::onDirectoryChanged(DirectoryChanges& changes) {
+    if (changes.rescan) {
+        // Events were lost; this is the only case that needs a full reload.
+        DNLOG_WARNING("TFilePanel: Change notifications overflowed, reloading", currentPath.string());
+        std::string focusName = focusedItemIndex < fileList.size() ? std::string(fileList.name(focusedItemIndex)) : "";
+        loadDirectory(currentPath);
+        pendingFocusName = std::move(focusName);
+    } else if (loader.isRunning()) {
+        // The entries may or may not be part of batches still to come.
+        deferredChanges.push_back(std::move(changes));
+    } else {
+        applyChanges(changes);
+    }
+}
 
-    // Combine the sorted lists: parent (".."), then directories, then files.
-    fileList.insert(fileList.end(), std::make_move_iterator(dirs.begin()), std::make_move_iterator(dirs.end()));
-    fileList.insert(fileList.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+void TFilePanel::applyChanges(DirectoryChanges& changes) {
+    if (changes.updated.empty() && changes.removed.empty()) return;
 
-    Logger::getInstance().log("TFilePanel: Found items", fileList.size());
-    setFocusedIndex(0); // Focus the first item in the new list.
+    std::string focusName = focusedItemIndex < fileList.size() ? std::string(fileList.name(focusedItemIndex)) : "";
+    size_t focusRow = rowOf(focusedItemIndex);
+    focusRow -= std::min(topItemIndex, focusRow);
+
+    // Changed entries are taken out too and merged back in with their fresh
+    // metadata, since their position in the sort order may have changed.
+    std::unordered_set<std::string_view> names;
+    std::bitset<256> nameLengths; // Cheap pre-filter before hashing.
+    for (const FileList* list : {&changes.removed, &changes.updated}) {
+        for (const auto& e : *list) {
+            names.insert(list->name(e));
+            nameLengths.set(std::min<size_t>(e.nameLength, 255));
+        }
+    }
+
+    // Entries that are taken out and come back updated stay selected.
+    selection.save(fileList);
+    std::unordered_set<std::string> reselect;
+
+    size_t kept = 0, removedAbove = 0;
+    for (size_t i = 0; i < fileList.size(); ++i) {
+        const FileEntry& e = fileList[i];
+        if (nameLengths.test(std::min<size_t>(e.nameLength, 255)) && names.contains(fileList.name(e))
+            && fileList.name(e) != "..") {
+            removedAbove += (i < focusedItemIndex);
+            if (selection.test(i)) reselect.emplace(fileList.name(e));
+            continue;
+        }
+        fileList[kept++] = e;
+    }
+    fileList.truncate(kept);
+
+    listSorter.sort(changes.updated);
+    size_t sortedSize = fileList.size();
+    fileList.append(changes.updated);
+    // The updated entries' names were appended to the arena after all others.
+    uint32_t firstUpdated = fileList.size() > sortedSize ? fileList[sortedSize].nameOffset : UINT32_MAX;
+    std::inplace_merge(fileList.begin(), fileList.begin() + sortedSize, fileList.end(), listSorter.lessFn(fileList));
+    selection.restore(fileList);
+    if (!reselect.empty()) {
+        for (size_t i = 0; i < fileList.size(); ++i) {
+            if (fileList[i].nameOffset >= firstUpdated && reselect.contains(std::string(fileList.name(i)))) {
+                selection.set(fileList, i, true);
+            }
+        }
+    }
+    listChanged();
+
+    // Keep the focus on the same entry if it still exists, or else on the one
+    // that took its place, and keep it on the same row of the panel.
+    auto it = std::ranges::find_if(fileList, [&](const FileEntry& e) { return fileList.name(e) == focusName; });
+    size_t newIndex = it != fileList.end() ? size_t(it - fileList.begin()) : focusedItemIndex - removedAbove;
+    if (!fileList.empty()) newIndex = std::min(newIndex, fileList.size() - 1);
+    size_t newRow = rowOf(newIndex);
+    topItemIndex = newRow - std::min(focusRow, newRow);
+    setFocusedIndex(newIndex);
+
+    size_t dead = fileList.deadNameBytes();
+    if (dead >= MIN_DEAD_NAME_BYTES && dead > fileList.nameBytes() - dead) compactNames();
 }
 
-void TFilePanel::setFocusedIndex(size_t newIndex) {
-    if (fileList.empty()) {
-        focusedItemIndex = 0;
-        topItemIndex = 0;
+void TFilePanel::compactNames() {
+    // The totals being added up would be lost, so this waits until they are done.
+    if (sizer.isRunning()) return;
+    DNLOG_DEBUG("TFilePanel: Compacting the names (dead bytes, arena bytes)", fileList.deadNameBytes(), fileList.nameBytes());
+    // The entries keep their indexes, and so the selection and the filter.
+    fileList.compact();
+    ++listVersion; // For indexOf().
+    // The metadata requests in flight know the entries by their old offsets;
+    // they are dropped and made again.
+    fetcher.reset(currentPath);
+    metadataRequested.clear();
+    requestSelectedMetadata();
+    if (bulkTotal > 0) {
+        bulkTotal = bulkDone = 0;
+        applySortOrder();
+    }
+    drawView(); // Asks for the rows on screen.
+}
+
+void TFilePanel::refreshEntry(std::string_view name) {
+    DirectoryChanges changes;
+    DirEntryInfo info;
+    if (statDirEntry(currentPath / name, info)) {
+        copyMetadata(info, changes.updated.add(name, info.type));
+    } else {
+        changes.removed.add(name, FileEntryType::File);
+    }
+    if (loader.isRunning()) {
+        deferredChanges.push_back(std::move(changes));
+    } else {
+        applyChanges(changes);
+    }
+}
+
+bool TFilePanel::focusEntry(std::string_view name) {
+    auto it = std::ranges::find_if(fileList, [&](const FileEntry& e) { return fileList.name(e) == name; });
+    if (it != fileList.end()) {
+        setFocusedIndex(it - fileList.begin());
+        return true;
+    }
+    if (loader.isRunning()) {
+        pendingFocusName = name;
+    }
+    return false;
+}
+
+bool TFilePanel::handleTypeAhead(TEvent& event) {
+    ushort key = event.keyDown.keyCode;
+    if (char c = getAltChar(key)) {
+        // Alt+letter starts a new quick search, also while a filter is on.
+        typeAhead = TypeAhead::QuickSearch;
+        quickSearchText.clear();
+        quickSearch(std::string_view(&c, 1), 0);
+        drawView();
+        return true;
+    }
+    if (key == kbCtrlF) {
+        typeAhead = TypeAhead::Filter;
+        quickSearchText.clear();
+        drawView();
+        return true;
+    }
+    if (key == kbEsc && (typeAhead != TypeAhead::None || isFiltered())) {
+        // Ends a quick search; otherwise takes the filter off.
+        if (typeAhead != TypeAhead::QuickSearch) setFilter({});
+        typeAhead = TypeAhead::None;
+        quickSearchText.clear();
+        drawView();
+        return true;
+    }
+    if (typeAhead == TypeAhead::None) return false;
+
+    bool quick = typeAhead == TypeAhead::QuickSearch;
+    const std::string& text = quick ? quickSearchText : filterText;
+    if (key == kbBack) {
+        if (text.empty()) return true;
+        // Drop the last character, with all the bytes of its UTF-8 sequence.
+        size_t length = text.size() - 1;
+        while (length > 0 && (uint8_t(text[length]) & 0xC0) == 0x80) --length;
+        std::string shorter = text.substr(0, length);
+        if (quick) {
+            // The focus stays where it is if nothing is typed any more.
+            quickSearchText.clear();
+            if (!shorter.empty()) quickSearch(shorter, 0);
+        } else {
+            setFilter(std::move(shorter));
+        }
+        drawView();
+        return true;
+    }
+    TStringView typed = event.keyDown.getText();
+    if (!typed.empty() && uint8_t(typed[0]) >= ' ' && !(event.keyDown.controlKeyState & kbCtrlShift)) {
+        std::string longer = text + std::string(typed.data(), typed.size());
+        if (quick) {
+            // A longer prefix can only match further down; without a match
+            // the character is not taken.
+            quickSearch(longer, rowOf(focusedItemIndex));
+        } else {
+            setFilter(std::move(longer));
+        }
+        drawView();
+        return true;
+    }
+    // Any other key ends a quick search and does what it does anyway; the
+    // filter stays on.
+    if (quick) {
+        typeAhead = TypeAhead::None;
+        quickSearchText.clear();
+        drawView();
+    }
+    return false;
+}
+
+bool TFilePanel::quickSearch(std::string_view text, size_t fromRow) {
+    for (size_t row = fromRow; row < rowCount(); ++row) {
+        if (startsWithIgnoringCase(fileList.name(entryAt(row)), text)) {
+            quickSearchText = text;
+            setFocusedRow(row);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TFilePanel::setFilter(std::string text) {
+    // The focused entry stays on the same row of the panel if it passes the
+    // filter; otherwise the next one that does takes its place.
+    size_t focusRow = rowOf(focusedItemIndex);
+    focusRow -= std::min(topItemIndex, focusRow);
+    // A longer mask can match more, e.g. "*.c" and "*.cpp".
+    bool narrowing = isFiltered() && text.starts_with(filterText) && !FileMask::isMask(text);
+    filterText = std::move(text);
+    if (narrowing) {
+        ScopedTimer timer(Probe::Filter);
+        // Only names that passed the shorter filter can pass this one.
+        ContentMatcher matcher(filterText, false);
+        std::erase_if(filteredIndexes, [&](uint32_t i) {
+            return matcher.find(fileList.name(i)) == std::string_view::npos;
+        });
+    } else if (isFiltered()) {
+        applyFilter();
+    } else {
+        filteredIndexes.clear();
+    }
+    ++listVersion; // The rows have changed, though the listing hasn't.
+
+    size_t index = std::min(focusedItemIndex, fileList.size());
+    size_t newRow = rowOf(index);
+    topItemIndex = newRow - std::min(focusRow, newRow);
+    setFocusedIndex(index);
+}
+
+void TFilePanel::applyFilter() {
+    ScopedTimer timer(Probe::Filter);
+    filteredIndexes.clear();
+    auto filter = [&](auto&& passes) {
+        for (size_t i = 0; i < fileList.size(); ++i) {
+            if (passes(fileList.name(i))) filteredIndexes.push_back(uint32_t(i));
+        }
+    };
+    // Text with wildcards or separators is a mask, e.g. "*.cpp;*.h;-*.bak";
+    // other text matches the names it is part of.
+    if (FileMask::isMask(filterText)) {
+        FileMask mask(filterText);
+        filter([&](std::string_view name) { return mask.matches(name); });
+    } else {
+        ContentMatcher matcher(filterText, false);
+        filter([&](std::string_view name) { return matcher.find(name) != std::string_view::npos; });
+    }
+}
+
+std::vector<std::string> TFilePanel::selectedNames() const {
+    std::vector<std::string> names;
+    names.reserve(selection.count());
+    selection.forEach([&](size_t i) { names.emplace_back(fileList.name(i)); });
+    return names;
+}
+
+void TFilePanel::clearSelection() {
+    if (selection.empty()) return;
+    selection.clear();
+    drawView();
+}
+
+void TFilePanel::selectByMask(Selection::Op op) {
+    if (op != Selection::Op::Invert) {
+        std::vector<char> mask(256, '\0');
+        selectMask.copy(mask.data(), mask.size() - 1);
+        const char* title = op == Selection::Op::Select ? "Select" : "Unselect";
+        if (inputBox(title, "Mask:", mask.data(), mask.size() - 1) != cmOK) return;
+        selectMask = mask.data();
+    }
+    changeSelection(op, FileMask(op == Selection::Op::Invert ? "*" : selectMask));
+}
+
+void TFilePanel::changeSelection(Selection::Op op, const FileMask& mask) {
+    // Masks select files only; unselecting takes directories too. The
+    // entries hidden by a filter are left alone.
+    auto shown = [&](size_t i) {
+        return !isFiltered() || std::ranges::binary_search(filteredIndexes, uint32_t(i));
+    };
+    selection.apply(fileList, op, [&](size_t i) {
+        const FileEntry& e = fileList[i];
+        if (op != Selection::Op::Deselect && e.type == FileEntryType::Directory) return false;
+        std::string_view name = fileList.name(e);
+        return name != ".." && mask.matches(name) && shown(i);
+    });
+    requestSelectedMetadata();
+    drawView();
+}
+
+void TFilePanel::requestSelectedMetadata() {
+    std::vector<size_t> indexes;
+    selection.forEach([&](size_t i) {
+        const FileEntry& e = fileList[i];
+        if (!e.hasStat && e.type == FileEntryType::File && metadataRequested.insert(e.nameOffset).second) {
+            indexes.push_back(i);
+        }
+    });
+    fetcher.fetch(fileList, indexes, true);
+}
+
+void TFilePanel::setSortMode(SortMode mode) {
+    if (mode == sorter.mode()) return;
+    DNLOG_DEBUG("TFilePanel::setSortMode", int(mode));
+
+    sorter = FileSorter(mode);
+    if (mode == SortMode::Unsorted) {
+        // The unsorted order is the order in which the directory is read.
+        std::string focusName = focusedItemIndex < fileList.size() ? std::string(fileList.name(focusedItemIndex)) : "";
+        loadDirectory(currentPath);
+        pendingFocusName = std::move(focusName);
         return;
     }
+    // Batches still in flight are sorted the old way; onLoadFinished() gets
+    // to the new order once they are all in.
+    if (!loader.isRunning()) {
+        applySortOrder();
+    }
+}
 
-    // Clamp the new index to be within the valid range of the file list.
-    focusedItemIndex = std::clamp(newIndex, size_t(0), fileList.size() - 1);
+void TFilePanel::applySortOrder() {
+    if (listSorter.mode() == sorter.mode()) return;
+
+    if (sorter.needsMetadata()) {
+        // Sizes and times are read in parallel in the background, with the
+        // progress shown by drawProgress(); onMetadataFetched() sorts at the end.
+        if (bulkTotal > 0) return;
+        std::vector<size_t> missing;
+        for (size_t i = 0; i < fileList.size(); ++i) {
+            if (!fileList[i].hasStat && fileList.name(i) != "..") missing.push_back(i);
+        }
+        if (!missing.empty()) {
+            DNLOG_DEBUG("TFilePanel: Reading metadata for sorting", missing.size());
+            bulkTotal = missing.size();
+            bulkDone = 0;
+            fetcher.fetch(fileList, missing, false);
+            drawView();
+            return;
+        }
+    }
+    sortList();
+}
 
-    // Adjust the visible portion of the list (scrolling).
-    int clientHeight = size.y;
-    if (clientHeight <= 0) clientHeight = 1;
+void TFilePanel::sortList() {
+    ScopedTimer timer(Probe::SortList);
+    // Entries are identified by their name's position in the arena, which sorting doesn't change.
+    uint32_t focusedName = focusedItemIndex < fileList.size() ? fileList[focusedItemIndex].nameOffset : 0;
+    selection.save(fileList);
+    sorter.sort(fileList);
+    selection.restore(fileList);
+    listSorter = sorter;
+    listChanged();
+    auto it = std::ranges::find_if(fileList, [&](const FileEntry& e) { return e.nameOffset == focusedName; });
+    setFocusedIndex(it != fileList.end() ? std::distance(fileList.begin(), it) : 0);
+}
 
-    if (focusedItemIndex < topItemIndex) {
-        // Scroll up if focus moves above the visible area.
-        topItemIndex = focusedItemIndex;
-    } else if (focusedItemIndex >= topItemIndex + clientHeight) {
-        // Scroll down if focus moves below the visible area.
-        topItemIndex = focusedItemIndex - clientHeight + 1;
+void TFilePanel::setView(PanelView aView, int columns) {
+    DNLOG_DEBUG("TFilePanel::setView", int(aView));
+    view = aView;
+    briefColumns = columns;
+    updateLayout();
+    setFocusedIndex(focusedItemIndex); // Scroll it into view with the new page size.
+    drawView();
+}
+
+void TFilePanel::updateLayout() {
+    layout = PanelLayout::compute(view, briefColumns, size);
+}
+
+size_t TFilePanel::pageSize() const {
+    return size_t(std::max(size.y, 1)) * layout.columns;
+}
+
+void TFilePanel::requestMetadata(size_t first, size_t last) {
+    std::vector<size_t> indexes;
+    for (size_t row = first; row < last; ++row) {
+        size_t i = entryAt(row);
+        const FileEntry& e = fileList[i];
+        if (e.hasStat || fileList.name(e) == "..") continue;
+        if (metadataRequested.insert(e.nameOffset).second) indexes.push_back(i);
+    }
+    fetcher.fetch(fileList, indexes, true);
+}
+
+void TFilePanel::onMetadataFetched(MetadataFetcher::Result& result) {
+    size_t page = pageSize();
+    bool onScreen = false;
+    uint64_t selectedBytes = selection.bytes();
+    for (size_t k = 0; k < result.keys.size(); ++k) {
+        const FileEntry& fetched = result.entries[k];
+        size_t i = indexOf(result.keys[k]);
+        if (!fetched.hasStat || i == SIZE_MAX || fileList[i].hasStat) continue;
+        FileEntry& e = fileList[i];
+        uint64_t oldSize = Selection::entrySize(e);
+        e.hasStat = true;
+        e.mode = fetched.mode;
+        if (!e.hasTreeSize) e.size = fetched.size;
+        e.mtime = fetched.mtime;
+        selection.sizeChanged(i, oldSize, Selection::entrySize(e));
+        size_t row = rowOf(i);
+        onScreen |= row >= topItemIndex && row < topItemIndex + page;
+    }
+    // The total on the last line.
+    onScreen |= selection.bytes() != selectedBytes;
+
+    if (!result.urgent && bulkTotal > 0) {
+        bulkDone += result.keys.size();
+        if (bulkDone >= bulkTotal) {
+            DNLOG_DEBUG("TFilePanel: Metadata read for sorting", bulkTotal);
+            bulkTotal = bulkDone = 0;
+            if (listSorter.mode() != sorter.mode()) {
+                sortList();
+            }
+            drawView(); // Also takes the progress off.
+            return;
+        }
+        if (!onScreen && size.y > 0 && exposed()) {
+            drawLine(size.y - 1, lineBuffer()); // The progress.
+        }
+    }
+    if (onScreen) {
+        drawView();
     }
+}
+
+void TFilePanel::calculateSizes(const std::vector<size_t>& indexes) {
+    sizer.calculate(currentPath, fileList, indexes);
+}
+
+void TFilePanel::onSizeCalculated(DirectorySizer::Result& result) {
+    size_t i = indexOf(result.key);
+    if (i == SIZE_MAX || fileList[i].type != FileEntryType::Directory) return;
+    FileEntry& e = fileList[i];
+    uint64_t oldSize = Selection::entrySize(e);
+    e.hasTreeSize = true;
+    e.size = result.bytes;
+    selection.sizeChanged(i, oldSize, e.size);
+    if (result.done) {
+        DNLOG_DEBUG("TFilePanel: Directory size (name, bytes, files)", fileList.name(e), result.bytes, result.files);
+    }
+    if (selection.test(i)) {
+        drawView(); // The total on the last line too.
+    } else {
+        drawRow(i); // If it's on screen.
+    }
+}
+
+size_t TFilePanel::indexOf(const MetadataFetcher::Key& key) {
+    if (key.index < fileList.size() && fileList[key.index].nameOffset == key.id) {
+        return key.index;
+    }
+    // The entry has moved since it was requested.
+    if (indexByIdVersion != listVersion) {
+        indexById.clear();
+        for (size_t i = 0; i < fileList.size(); ++i) {
+            indexById.emplace(fileList[i].nameOffset, i);
+        }
+        indexByIdVersion = listVersion;
+    }
+    auto it = indexById.find(key.id);
+    return it != indexById.end() ? it->second : SIZE_MAX;
+}
+
+void TFilePanel::listChanged() {
+    ++listVersion;
+    // Entries may have come, gone or moved, so the filter starts over.
+    if (isFiltered()) applyFilter();
+}
+
+size_t TFilePanel::rowOf(size_t index) const {
+    if (!isFiltered()) return index;
+    return std::ranges::lower_bound(filteredIndexes, index) - filteredIndexes.begin();
+}
+
+void TFilePanel::setFocusedIndex(size_t newIndex) {
+    size_t oldFocusedIndex = focusedItemIndex;
+    size_t rows = rowCount();
+
+    if (rows == 0) {
+        focusedItemIndex = fileList.size(); // Nothing is focused.
+        topItemIndex = 0;
+    } else {
+        // Clamp the new index to be within the valid range of the file list;
+        // an entry the filter hides passes the focus on to the next row.
+        size_t row = std::min(rowOf(std::min(newIndex, fileList.size() - 1)), rows - 1);
+        focusedItemIndex = entryAt(row);
+
+        // Adjust the visible portion of the list (scrolling). In brief view
+        // the columns continue one another, so the page scrolls as a whole.
+        size_t page = pageSize();
+        if (row < topItemIndex) {
+            // Scroll up if focus moves above the visible area.
+            topItemIndex = row;
+        } else if (row >= topItemIndex + page) {
+            // Scroll down if focus moves below the visible area.
+            topItemIndex = row - page + 1;
+        }
+    }
+
+    // If the screen shows exactly this listing at this scroll position, only
+    // the lines of the old and new focus change; otherwise redraw everything.
+    bool sameRows = drawnListVersion == listVersion && drawnTopIndex == topItemIndex;
+    if (!sameRows) {
+        drawView();
+    } else if (focusedItemIndex != oldFocusedIndex) {
+        drawRow(oldFocusedIndex);
+        drawRow(focusedItemIndex);
+    }
+}
+
+void TFilePanel::setFocusedRow(size_t row) {
+    size_t rows = rowCount();
+    setFocusedIndex(rows > 0 ? entryAt(std::min(row, rows - 1)) : 0);
+}
+
+void TFilePanel::drawRow(size_t listIndex) {
+    size_t row = rowOf(listIndex);
+    if (row < topItemIndex || row >= topItemIndex + pageSize() || !exposed()) return;
+    drawLine(int((row - topItemIndex) % std::max(size.y, 1)), lineBuffer());
+}
 
-    drawView(); // Redraw to reflect the change in focus/scrolling.
+TDrawBuffer& TFilePanel::lineBuffer() {
+    // TDrawBuffer allocates its cells on the heap and is sized after the screen,
+    // so one is kept around and only replaced when the bounds change.
+    if (!drawBuffer) drawBuffer = std::make_unique<TDrawBuffer>();
+    return *drawBuffer;
+}
+
+void TFilePanel::changeBounds(const TRect& bounds) {
+    drawBuffer.reset();
+    TGroup::changeBounds(bounds);
+    updateLayout();
+}
+
+void TFilePanel::formatLine(TDrawBuffer& b, const FileList& list, const PanelLayout& layout, int rows,
+                            size_t top, int y, size_t focused, const PanelColors& colors,
+                            const std::vector<uint32_t>* shown, const Selection* selection) {
+    // Entries run down the columns, as in Dos Navigator.
+    size_t count = shown ? shown->size() : list.size();
+    int x = 0;
+    for (int column = 0; column < layout.columns; ++column) {
+        if (column > 0) b.moveChar(x++, COLUMN_SEPARATOR, colors.normal, 1);
+        int width = column + 1 < layout.columns ? layout.columnWidth : layout.width - x;
+        size_t row = top + size_t(column) * rows + y;
+        size_t index = row < count && shown ? (*shown)[row] : row;
+        bool selected = selection && selection->test(index);
+        TColorAttr color = row == focused ? (selected ? colors.focusedSelected : colors.focused)
+                                          : (selected ? colors.selected : colors.normal);
+        b.moveChar(x, ' ', color, width); // Clear the cell with the correct background color.
+        if (row < count && width > 0) {
+            formatEntry(b, x, width, list, list[index], layout, color);
+        }
+        x += width;
+    }
 }
 
 void TFilePanel::changeDirectory(const std::filesystem::path& newPathFragment) {
@@ -196,91 +989,273 @@ void TFilePanel::changeDirectory(const std::filesystem::path& newPathFragment) {
         newPath = currentPath / newPathFragment;
     }
 
+    storeInCache();
     loadDirectory(newPath);
 
-    // After loading the new directory, try to set focus on the directory we just left.
+    // Focus on the directory we just left, now or once it has been loaded.
     if (!focusOnName.empty()) {
-        auto it = std::ranges::find_if(fileList, [&](const auto& entry) {
-            return entry->path.filename() == focusOnName;
-        });
-        if (it != fileList.end()) {
-            setFocusedIndex(std::distance(fileList.begin(), it));
-        }
+        focusEntry(focusOnName);
+    }
+}
+
+void TFilePanel::showEntry(const std::filesystem::path& path) {
+    if (path.parent_path() != currentPath) {
+        storeInCache();
+        loadDirectory(path.parent_path());
     }
+    focusEntry(path.filename().string());
+}
+
+std::string_view TFilePanel::focusedName() const {
+    if (focusedItemIndex >= fileList.size()) return {};
+    return fileList.name(focusedItemIndex);
 }
 
 void TFilePanel::executeFocusedItem() {
     if (fileList.empty() || focusedItemIndex >= fileList.size()) return;
 
-    const auto& item = fileList[focusedItemIndex];
-    Logger::getInstance().log("TFilePanel::executeFocusedItem", item->path.string());
+    const FileEntry& item = fileList[focusedItemIndex];
+    std::string name(fileList.name(item));
+    DNLOG_DEBUG("TFilePanel::executeFocusedItem", name);
 
-    if (item->type == FileEntryType::Directory) {
-        changeDirectory(item->path);
+    if (item.type == FileEntryType::Directory) {
+        changeDirectory(name);
     } else {
         // TODO: Implement file execution/viewing logic.
-        Logger::getInstance().log("File execution is not yet implemented.");
+        DNLOG_INFO("File execution is not yet implemented.");
+    }
+}
+
+void TFilePanel::viewFocusedItem() {
+    if (focusedItemIndex >= fileList.size() || !TProgram::deskTop) return;
+    std::filesystem::path path = currentPath / fileList.name(focusedItemIndex);
+    auto* window = new TViewerWindow(TProgram::deskTop->getExtent(), path);
+    if (!window->error().empty()) {
+        DNLOG_ERROR("TFilePanel: Cannot view", path.string(), window->error());
+        messageBox(std::format("Cannot view {}: {}", fileList.name(focusedItemIndex), window->error()), mfError | mfOKButton);
+        TObject::destroy(window);
+        return;
     }
+    TProgram::deskTop->insert(window);
 }
 
 void TFilePanel::handleEvent(TEvent& event) {
     TGroup::handleEvent(event);
 
     if (event.what == evKeyDown && (state & sfFocused)) {
+        if (handleTypeAhead(event)) {
+            clearEvent(event);
+            return;
+        }
+        size_t focusedRow = rowOf(focusedItemIndex);
         switch (event.keyDown.keyCode) {
             case kbCtrlEnter:
                 messageBox("Ctrl+Enter pressed", mfOKButton); // For tests
                 break;
             case kbUp:
-                setFocusedIndex(focusedItemIndex - 1);
+                setFocusedRow(focusedRow - 1);
                 clearEvent(event);
                 break;
             case kbDown:
-                setFocusedIndex(focusedItemIndex + 1);
+                setFocusedRow(focusedRow + 1);
+                clearEvent(event);
+                break;
+            case kbLeft: // To the previous column.
+                setFocusedRow(focusedRow - std::min<size_t>(focusedRow, std::max(size.y, 1)));
+                clearEvent(event);
+                break;
+            case kbRight: // To the next column.
+                setFocusedRow(focusedRow + std::max(size.y, 1));
+                clearEvent(event);
+                break;
+            case kbPgUp:
+                setFocusedRow(focusedRow - std::min(focusedRow, pageSize()));
+                clearEvent(event);
+                break;
+            case kbPgDn:
+                setFocusedRow(focusedRow + pageSize());
+                clearEvent(event);
+                break;
+            case kbHome:
+                setFocusedRow(0);
+                clearEvent(event);
+                break;
+            case kbEnd:
+                setFocusedRow(rowCount());
                 clearEvent(event);
                 break;
             case kbEnter:
                 executeFocusedItem();
                 clearEvent(event);
                 break;
+            // Selection, as in Dos Navigator.
+            case kbIns:
+                if (focusedItemIndex < fileList.size() && fileList.name(focusedItemIndex) != "..") {
+                    selection.set(fileList, focusedItemIndex, !selection.test(focusedItemIndex));
+                    requestSelectedMetadata();
+                    drawView(); // The row and the total.
+                }
+                setFocusedRow(focusedRow + 1);
+                clearEvent(event);
+                break;
+            case kbGrayPlus:
+                selectByMask(Selection::Op::Select);
+                clearEvent(event);
+                break;
+            case kbGrayMinus:
+                selectByMask(Selection::Op::Deselect);
+                clearEvent(event);
+                break;
+            case GRAY_STAR:
+                selectByMask(Selection::Op::Invert);
+                clearEvent(event);
+                break;
             case kbCtrlPgUp: // Common shortcut for parent directory
                 changeDirectory("..");
                 clearEvent(event);
                 break;
+            // Sort orders, as in Dos Navigator.
+            case kbCtrlF3:
+                setSortMode(SortMode::Name);
+                clearEvent(event);
+                break;
+            case kbCtrlF4:
+                setSortMode(SortMode::Extension);
+                clearEvent(event);
+                break;
+            case kbCtrlF5:
+                setSortMode(SortMode::Time);
+                clearEvent(event);
+                break;
+            case kbCtrlF6:
+                setSortMode(SortMode::Size);
+                clearEvent(event);
+                break;
+            case kbCtrlF7:
+                setSortMode(SortMode::Unsorted);
+                clearEvent(event);
+                break;
+            // Cycles through brief view with two and three columns and full view.
+            case kbCtrlF8:
+                if (view == PanelView::Full) {
+                    setView(PanelView::Brief, 2);
+                } else if (briefColumns < 3) {
+                    setView(PanelView::Brief, 3);
+                } else {
+                    setView(PanelView::Full, briefColumns);
+                }
+                clearEvent(event);
+                break;
+            // The size of the trees of the selected directories, or else the
+            // focused one's; on "..", of all of them. A file is viewed.
+            case kbF3:
+                if (focusedItemIndex < fileList.size() && fileList[focusedItemIndex].type != FileEntryType::Directory) {
+                    viewFocusedItem();
+                    clearEvent(event);
+                } else if (focusedItemIndex < fileList.size()) {
+                    // Like F5, F6 and F8, it acts on the selection if there is one.
+                    std::vector<size_t> indexes;
+                    selection.forEach([&](size_t i) {
+                        if (fileList[i].type == FileEntryType::Directory) indexes.push_back(i);
+                    });
+                    if (indexes.empty() && fileList.name(focusedItemIndex) != "..") {
+                        indexes.push_back(focusedItemIndex);
+                    } else if (indexes.empty()) {
+                        for (size_t i = 0; i < fileList.size(); ++i) {
+                            if (fileList[i].type == FileEntryType::Directory && i != focusedItemIndex) indexes.push_back(i);
+                        }
+                    }
+                    calculateSizes(indexes);
+                    clearEvent(event);
+                }
+                break;
+            case kbEsc:
+                // Stop a scan in progress; whatever was loaded so far stays listed.
+                if (loader.isRunning()) {
+                    loader.cancel();
+                    DNLOG_INFO("TFilePanel: Directory scan cancelled", fileList.size());
+                    finishLoading();
+                    clearEvent(event);
+                } else if (sizer.isRunning()) {
+                    // The totals so far stay shown.
+                    sizer.cancel();
+                    clearEvent(event);
+                }
+                break;
         }
     }
 }
 
-void TFilePanel::drawItem(int y_in_client_area, size_t list_index, bool isFocused, TDrawBuffer& b) {
-    // Determine color based on focus state.
-    TColorAttr color = (isFocused && (state & sfFocused)) ? getColor(4) : getColor(1);
-
-    b.moveChar(0, ' ', color, size.x); // Clear the line with the correct background color.
+void TFilePanel::drawLine(int y, TDrawBuffer& b) {
+    ScopedTimer timer(Probe::DrawLine);
+    // Determine colors based on focus state.
+    PanelColors colors;
+    colors.normal = getColor(1);
+    colors.focused = (state & sfFocused) ? getColor(4) : colors.normal;
+    // Selected entries have the text color of the window's highlighted text.
+    colors.selected = getColor(6);
+    colors.focusedSelected = colors.focused;
+    setFore(colors.focusedSelected, getFore(colors.selected));
 
-    if (list_index < fileList.size()) {
-        const auto& item = fileList[list_index];
-        std::string displayName = item->path.string();
-
-        static constexpr std::string_view DIR_PREFIX = "[";
-        static constexpr std::string_view DIR_SUFFIX = "]";
-        if (item->type == FileEntryType::Directory) {
-            displayName = std::format("{}{}{}", DIR_PREFIX, displayName, DIR_SUFFIX);
+    formatLine(b, fileList, layout, size.y, topItemIndex, y, rowOf(focusedItemIndex), colors,
+               isFiltered() ? &filteredIndexes : nullptr, &selection);
+    if (y == size.y - 1) {
+        if (typeAhead != TypeAhead::None || isFiltered()) {
+            drawTypeAhead(b);
+        } else if (bulkTotal > 0) {
+            drawProgress(b);
+        } else if (!selection.empty()) {
+            drawSelectionInfo(b);
         }
-
-        // Use TStringView for efficient substring handling and writing to the buffer.
-        b.moveStr(0, TStringView(displayName), color);
     }
+    writeLine(0, y, size.x, 1, b);
+}
+
+void TFilePanel::drawProgress(TDrawBuffer& b) {
+    static constexpr std::string_view LABEL = " Reading file info ";
+    char percent[8];
+    char* end = std::to_chars(percent, percent + 3, std::min<size_t>(bulkDone * 100 / bulkTotal, 100)).ptr;
+    *end++ = '%';
+    *end++ = ' ';
+    TColorAttr color = getColor(4);
+    int x = b.moveStr(0, LABEL, color, size.x);
+    b.moveStr(x, std::string_view(percent, end - percent), color, size.x - x);
+}
+
+void TFilePanel::drawTypeAhead(TDrawBuffer& b) {
+    TColorAttr color = getColor(4);
+    bool quick = typeAhead == TypeAhead::QuickSearch;
+    int x = b.moveStr(0, quick ? " Search: " : " Filter: ", color, size.x);
+    x += b.moveStr(x, quick ? quickSearchText : filterText, color, size.x - x);
+    char count[48];
+    auto end = quick ? std::format_to_n(count, sizeof(count), " ").out
+                     : std::format_to_n(count, sizeof(count), " ({} of {}) ", rowCount(), fileList.size()).out;
+    b.moveStr(x, std::string_view(count, end - count), color, size.x - x);
+}
 
-    writeLine(0, y_in_client_area, size.x, 1, b);
+void TFilePanel::drawSelectionInfo(TDrawBuffer& b) {
+    char text[64];
+    auto end = std::format_to_n(text, sizeof(text), " {} bytes in {} selected ", selection.bytes(), selection.count()).out;
+    b.moveStr(0, std::string_view(text, end - text), getColor(4), size.x);
 }
 
 void TFilePanel::draw() {
+    ScopedTimer timer(Probe::PanelDraw);
     TGroup::draw(); // Draw the frame first.
 
-    TDrawBuffer b;
+    // Metadata is only read for the entries on screen and a page either side.
+    if (layout.showSize) {
+        size_t page = pageSize();
+        size_t first = std::min(topItemIndex - std::min(topItemIndex, page), rowCount());
+        requestMetadata(first, std::min(topItemIndex + 2 * page, rowCount()));
+    }
+
+    TDrawBuffer& b = lineBuffer();
     for (int y = 0; y < size.y; ++y) {
-        size_t currentListIndex = topItemIndex + y;
-        bool isFocused = (currentListIndex == focusedItemIndex);
-        drawItem(y, currentListIndex, isFocused, b);
+        drawLine(y, b);
     }
+
+    // Remember what the screen shows, for setFocusedIndex()'s partial redraws.
+    drawnListVersion = listVersion;
+    drawnTopIndex = topItemIndex;
 }
@@ -95,44 +95,227 @@
 #include <vector>
 #include <filesystem>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
-// A type-safe enum to represent the kind of entry in the file list.
-enum class FileEntryType { File, Directory };
+#include "filelist.h"
+#include "filesort.h"
+#include "dirload.h"
+#include "dirwatch.h"
+#include "dircache.h"
+#include "metafetch.h"
+#include "dirsize.h"
+#include "filemask.h"
+#include "selection.h"
 
-struct FileEntry {
-    std::filesystem::path path;
-    FileEntryType type;
+// How a panel arranges its entries, as in Dos Navigator.
+enum class PanelView : uint8_t {
+    Brief, // Names only, in several columns.
+    Full,  // One entry per line, with its size, date and time.
+};
+
+// The column geometry of a panel. It only depends on the view and the panel's
+// size, so it is worked out when a directory is loaded or the panel resized
+// rather than on every draw.
+struct PanelLayout {
+    PanelView view = PanelView::Brief;
+    int width = 0;       // Cells per line.
+    int columns = 1;     // Columns of entries side by side.
+    int columnWidth = 0; // Cells per column, not counting the separators; the last one takes the rest.
+    bool showSize = false;
+    bool showDateTime = false;
 
-    // Use an explicit constructor to prevent unintended conversions.
-    explicit FileEntry(std::filesystem::path p, FileEntryType t)
-        : path(std::move(p)), type(t) {}
+    // Lays out 'size' for 'view'; 'briefColumns' is an upper bound that is
+    // lowered if the columns would get too narrow.
+    static PanelLayout compute(PanelView view, int briefColumns, TPoint size);
+};
+
+// The colors a panel draws its entries in.
+struct PanelColors {
+    TColorAttr normal;
+    TColorAttr focused;
+    TColorAttr selected;
+    TColorAttr focusedSelected;
 };
 
 class TFilePanel : public TGroup {
 public:
-    TFilePanel(const TRect& bounds);
+    // 'cache' is an optional listing cache shared with other panels, and
+    // 'sizeCache' one of directory sizes; neither is owned.
+    TFilePanel(const TRect& bounds, DirectoryCache* cache = nullptr, DirSizeCache* sizeCache = nullptr);
 
     void draw() override;
     void handleEvent(TEvent& event) override;
     void setState(ushort aState, Boolean enable) override;
+    void changeBounds(const TRect& bounds) override;
 
     // Public read-only access to the current path.
     const std::filesystem::path& getCurrentPath() const { return currentPath; }
+    const FileList& getFileList() const { return fileList; }
+    // The name of the focused entry; empty if there is none.
+    std::string_view focusedName() const;
 
     // Reloads the file list from a given directory path.
+    // Unless the listing cache has it, the directory is enumerated in the
+    // background and entries appear as they arrive.
     void loadDirectory(const std::filesystem::path& path);
+    // True while the directory is still being enumerated.
+    bool isLoading() const { return loader.isRunning(); }
+
+    // Re-sorts the listing, keeping the focus on the same entry.
+    void setSortMode(SortMode mode);
+    // Switches between brief view with 'briefColumns' columns and full view.
+    void setView(PanelView view, int briefColumns);
+
+    // Re-reads a single entry right away, e.g. one the application just created,
+    // instead of waiting for the directory watcher to report it.
+    void refreshEntry(std::string_view name);
+    // Adds up the sizes of the trees of the directories at 'indexes' in the
+    // background; the size column shows the totals as they grow.
+    void calculateSizes(const std::vector<size_t>& indexes);
+
+    // Moves the focus to the named entry. If it isn't listed yet but the
+    // directory is still being loaded, it is focused as soon as it shows up.
+    bool focusEntry(std::string_view name);
+    // Goes to the directory 'path' is in, if the panel isn't there already,
+    // and focuses its entry.
+    void showEntry(const std::filesystem::path& path);
+
+    // The names of the selected entries, in listing order.
+    std::vector<std::string> selectedNames() const;
+    void clearSelection();
+
+    // Renders line 'y' of a panel with 'rows' lines showing 'list' from entry
+    // 'top' on into 'b'. If 'shown' is given, the panel shows only the entries
+    // it has the indexes of, and 'top' and 'focused' count those. Doesn't
+    // allocate; public so that it can be benchmarked in isolation.
+    static void formatLine(TDrawBuffer& b, const FileList& list, const PanelLayout& layout, int rows,
+                           size_t top, int y, size_t focused, const PanelColors& colors,
+                           const std::vector<uint32_t>* shown = nullptr, const Selection* selection = nullptr);
 
 private:
-    void drawItem(int y_in_client_area, size_t list_index, bool isFocused, TDrawBuffer& b);
+    void onBatchLoaded(DirectoryLoader::Batch& batch);
+    void onLoadFinished(std::error_code ec);
+    // What is left to do once the scan is over, done or cancelled: applies
+    // the changes deferred meanwhile, sorts and focuses the entry asked for.
+    void finishLoading();
+    void onDirectoryChanged(DirectoryChanges& changes);
+    void applyChanges(DirectoryChanges& changes);
+    // Drops the names of entries no longer listed from fileList's arena.
+    void compactNames();
+    bool loadFromCache();
+    void storeInCache();
+    void drawLine(int y, TDrawBuffer& b);
+    void drawRow(size_t listIndex);
+    TDrawBuffer& lineBuffer();
+    void drawProgress(TDrawBuffer& b);
+    void drawTypeAhead(TDrawBuffer& b);
+    void drawSelectionInfo(TDrawBuffer& b);
+    void updateLayout();
+    size_t pageSize() const;
+    // Brings the listing into the order of 'sorter', possibly after reading
+    // the metadata for it in the background.
+    void applySortOrder();
+    void sortList();
+    // Queues the entries on rows [first, last) that have no metadata yet.
+    void requestMetadata(size_t first, size_t last);
+    void onMetadataFetched(MetadataFetcher::Result& result);
+    void onSizeCalculated(DirectorySizer::Result& result);
+    // Where the entry is now; SIZE_MAX if it's gone.
+    size_t indexOf(const MetadataFetcher::Key& key);
+    // Must be called after every modification of fileList.
+    void listChanged();
     void changeDirectory(const std::filesystem::path& newPathFragment);
     void executeFocusedItem();
+    // Opens the focused file in the viewer (F3).
+    void viewFocusedItem();
     void setFocusedIndex(size_t newIndex);
+    void setFocusedRow(size_t row);
+
+    // Rows are what the panel lists: all of fileList, or while a filter is on,
+    // the entries in filteredIndexes.
+    bool isFiltered() const { return !filterText.empty(); }
+    size_t rowCount() const { return isFiltered() ? filteredIndexes.size() : fileList.size(); }
+    size_t entryAt(size_t row) const { return isFiltered() ? filteredIndexes[row] : row; }
+    // The row of the entry at 'index'; if it is filtered out, the next row.
+    size_t rowOf(size_t index) const;
+    // Takes the keys that edit the quick search or the filter; false if the
+    // key is for the panel.
+    bool handleTypeAhead(TEvent& event);
+    bool quickSearch(std::string_view text, size_t fromRow);
+    void setFilter(std::string text);
+    // Rebuilds filteredIndexes from the whole listing.
+    void applyFilter();
+    // Selects or unselects the entries shown that match a mask asked for
+    // (Gray+, Gray-), or inverts the selection of the files shown (Gray*).
+    void selectByMask(Selection::Op op);
+    void changeSelection(Selection::Op op, const FileMask& mask);
+    // Reads the sizes of selected files that have no metadata yet, for the total.
+    void requestSelectedMetadata();
 
-    // Using unique_ptr to manage the lifetime of FileEntry objects automatically.
-    std::vector<std::unique_ptr<FileEntry>> fileList;
+    // Flat, arena-backed storage: the whole listing is a couple of allocations.
+    FileList fileList;
+    FileSorter sorter;     // The order asked for.
+    FileSorter listSorter; // The order fileList is in. Lags behind while metadata for 'sorter' is read.
     std::filesystem::path currentPath;
     size_t focusedItemIndex = 0;
-    size_t topItemIndex = 0; // Index of the item displayed at the top of the panel.
+    size_t topItemIndex = 0; // The row displayed at the top of the panel.
+
+    // Alt+letter starts a quick search, which moves the focus to the first
+    // name that starts with what is typed. Ctrl+F starts a filter, which lists
+    // only the names that contain it, or match it if it is a mask (see
+    // FileMask); it stays on until Esc or the directory is left. Both ignore
+    // ASCII case.
+    enum class TypeAhead : uint8_t { None, QuickSearch, Filter };
+    TypeAhead typeAhead = TypeAhead::None; // Where typed text goes.
+    std::string quickSearchText;
+    std::string filterText;
+    // The indexes of the entries that pass the filter, in listing order.
+    // Extending the filter narrows them down rather than going through the
+    // whole listing again.
+    std::vector<uint32_t> filteredIndexes;
+
+    // Entries picked with Ins and Gray+/Gray-/Gray*, for the file operations.
+    Selection selection;
+    std::string selectMask = "*.*"; // Last asked for by Gray+ and Gray-.
+
+    PanelView view = PanelView::Brief;
+    int briefColumns = 3;
+    PanelLayout layout;
+
+    DirectoryLoader loader;
+    // Name of the entry to focus once it shows up (e.g. the directory we came from).
+    std::string pendingFocusName;
+
+    // What draw() last put on screen: rows are only redrawn selectively while
+    // neither the listing nor the scroll position has changed since.
+    unsigned listVersion = 0;
+    unsigned drawnListVersion = ~0u;
+    size_t drawnTopIndex = 0;
+
+    std::unique_ptr<TDrawBuffer> drawBuffer; // Reused by all redraws; see lineBuffer().
+
+    DirectoryCache* cache;
+    // The directory's mtime before the current listing was read, for the cache.
+    DirectoryCache::Time listingMtime;
+    bool listingMtimeValid = false;
+    // Whether the scan read the whole directory; not after Esc or an error.
+    bool listingComplete = false;
+
+    MetadataFetcher fetcher;
+    std::unordered_set<uint32_t> metadataRequested; // By nameOffset; urgent requests only.
+    // Progress of the pass reading all missing metadata, for sorting by size or time.
+    size_t bulkTotal = 0;
+    size_t bulkDone = 0;
+    // nameOffset to index, for results whose entries have moved; rebuilt lazily.
+    std::unordered_map<uint32_t, size_t> indexById;
+    unsigned indexByIdVersion = ~0u;
+
+    DirectorySizer sizer;
+
+    DirectoryWatcher watcher;
+    // Changes reported while the directory is still loading are applied at the end.
+    std::vector<DirectoryChanges> deferredChanges;
 };
 
 #endif // FLPANEL_H
@@ -0,0 +1,465 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+// dn4l_headless: replays a scripted stream of events against the file panels
+// without a terminal, and reports how long every frame took and how many
+// bytes a terminal would have been sent for it.
+//
+//   dn4l_headless [--size COLSxROWS] [--entries N | --dir PATH]
+//                 [--script FILE] [--frames FILE]
+//
+// The double panel window is drawn into an off-screen buffer that stands in
+// for the screen; the menu bar and the status line are left out, and so are
+// commands that need the application, like message boxes. Both panels show
+// PATH, or a synthetic directory of N entries (100k by default). Without
+// --script, a built-in script scrolls through the listing. --frames writes
+// one CSV line per frame.
+//
+// A script has one command per line; '#' starts a comment.
+//
+//   wait                until both panels have loaded and background work has settled
+//   key NAME [COUNT]    presses a key, COUNT times; e.g. "key Down 1000"
+//   resize COLS ROWS    resizes the screen
+//
+// Frames are timed from the event to the end of the redraws it causes,
+// including the background results it waits for; 'wait' is not timed.
+// Bytes are those a terminal backend that only rewrites changed cells would
+// send, as worked out by updateBytes().
+
+#define Uses_TGroup
+#define Uses_TPalette
+#define Uses_TScreen
+#define Uses_TDrawBuffer
+#define Uses_TEvent
+#define Uses_TKeys
+#define Uses_TApplication
+#include <tvision/tv.h>
+
+#include "asyncq.h"
+#include "dblwnd.h"
+#include "dnprof.h"
+#include "flpanel.h"
+#include "synthtree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr TPoint DEFAULT_SIZE {80, 25};
+constexpr size_t DEFAULT_ENTRIES = 100000;
+// How long the panels must stay idle for a 'wait' to end.
+constexpr auto SETTLE_TIME = std::chrono::milliseconds(50);
+
+constexpr std::string_view DEFAULT_SCRIPT =
+    "wait\n"
+    "key Down 2000\n"
+    "key PgDn 500\n"
+    "key End\n"
+    "key PgUp 500\n"
+    "key Home\n"
+    "key Tab\n"
+    "key Right 200\n"
+    "resize 132 50\n"
+    "key PgDn 500\n";
+
+constexpr struct {
+    std::string_view name;
+    ushort code;
+} KEYS[] = {
+    {"Up", kbUp}, {"Down", kbDown}, {"Left", kbLeft}, {"Right", kbRight},
+    {"PgUp", kbPgUp}, {"PgDn", kbPgDn}, {"Home", kbHome}, {"End", kbEnd},
+    {"Enter", kbEnter}, {"Tab", kbTab}, {"Esc", kbEsc}, {"CtrlPgUp", kbCtrlPgUp},
+    {"CtrlF3", kbCtrlF3}, {"CtrlF4", kbCtrlF4}, {"CtrlF5", kbCtrlF5},
+    {"CtrlF6", kbCtrlF6}, {"CtrlF7", kbCtrlF7}, {"CtrlF8", kbCtrlF8},
+};
+
+struct Step {
+    enum Kind { Wait, Key, Resize } kind;
+    std::string text; // As written, for the frame log.
+    ushort keyCode = 0;
+    long count = 1;
+    TPoint size {};
+};
+
+// Stands in for the application: a buffered group without an owner. What its
+// subviews draw ends up in its buffer, as it would on the screen.
+class THeadlessScreen : public TGroup {
+public:
+    explicit THeadlessScreen(TPoint size) : TGroup(TRect(0, 0, size.x, size.y)) {
+        options |= ofBuffered;
+        // The state TProgram has as the top view of a live screen.
+        state |= sfActive | sfSelected | sfFocused | sfExposed;
+        getBuffer();
+    }
+
+    TPalette& getPalette() const override {
+        static TPalette palette(cpAppColor, sizeof(cpAppColor) - 1);
+        return palette;
+    }
+
+    std::span<const TScreenCell> cells() const { return {buffer, size_t(size.x) * size.y}; }
+};
+
+size_t decimalDigits(int value) {
+    size_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+// The bytes a terminal backend that only rewrites changed cells, like
+// tvision's, would send to turn 'before' into 'after'. Every run of changed
+// cells that doesn't continue the previous one costs a cursor move, every
+// change of attribute an SGR sequence, and every cell its text. An empty
+// 'before' means the whole screen is repainted.
+size_t updateBytes(std::span<const TScreenCell> before, std::span<const TScreenCell> after, int width) {
+    static constexpr size_t SGR_BYTES = 10; // A 16-color attribute, e.g. "\x1b[0;37;44m".
+    size_t bytes = 0;
+    size_t cursor = SIZE_MAX; // The cell the terminal would write next.
+    const TScreenCell* lastWritten = nullptr;
+    for (size_t i = 0; i < after.size(); ++i) {
+        const TScreenCell& cell = after[i];
+        if (before.size() == after.size() && std::memcmp(&before[i], &cell, sizeof(cell)) == 0) continue;
+        int x = int(i % width), y = int(i / width);
+        if (i != cursor || x == 0) {
+            bytes += 4 + decimalDigits(y + 1) + decimalDigits(x + 1); // "\x1b[y;xH"
+        }
+        if (!lastWritten || std::memcmp(&lastWritten->attr, &cell.attr, sizeof(cell.attr)) != 0) {
+            bytes += SGR_BYTES;
+        }
+        bytes += std::max<size_t>(cell._ch.getText().size(), 1);
+        lastWritten = &cell;
+        cursor = i + 1;
+    }
+    return bytes;
+}
+
+bool parseScript(std::istream& in, std::vector<Step>& steps) {
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        line.erase(std::min(line.find('#'), line.size()));
+        std::istringstream words(line);
+        std::string command;
+        if (!(words >> command)) continue;
+
+        Step step {Step::Wait, line};
+        bool ok = true;
+        if (command == "wait") {
+            step.kind = Step::Wait;
+        } else if (command == "key") {
+            std::string name;
+            ok = bool(words >> name);
+            step.kind = Step::Key;
+            auto it = std::find_if(std::begin(KEYS), std::end(KEYS), [&](const auto& k) { return k.name == name; });
+            ok = ok && it != std::end(KEYS);
+            if (ok) step.keyCode = it->code;
+            if (ok && !(words >> step.count)) step.count = 1;
+        } else if (command == "resize") {
+            int cols = 0, rows = 0;
+            ok = words >> cols >> rows && cols > 0 && rows > 0;
+            step.kind = Step::Resize;
+            step.size = {cols, rows};
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "dn4l_headless: script line %d: cannot parse \"%s\"\n", lineNumber, line.c_str());
+            return false;
+        }
+        steps.push_back(std::move(step));
+    }
+    return true;
+}
+
+class Harness {
+public:
+    Harness(TPoint size, const std::filesystem::path& dir, std::FILE* frameLog) : frameLog(frameLog) {
+        setScreenSize(size);
+        screen = new THeadlessScreen(size);
+        window = new TDoublePanelWindow(screen->getExtent(), "dn4l C++", 0);
+        screen->insert(window);
+        // The panels start out in the current directory.
+        settle();
+        window->leftPanel->loadDirectory(dir);
+        window->rightPanel->loadDirectory(dir);
+        settle();
+        screen->redraw();
+        endFrame("start", Clock::duration::zero(), false);
+    }
+
+    ~Harness() {
+        TObject::destroy(screen);
+    }
+
+    void run(const std::vector<Step>& steps) {
+        for (const auto& step : steps) {
+            switch (step.kind) {
+                case Step::Wait: {
+                    auto start = Clock::now();
+                    settle();
+                    endFrame(step.text, Clock::now() - start, false);
+                    break;
+                }
+                case Step::Key:
+                    for (long i = 0; i < step.count; ++i) {
+                        auto start = Clock::now();
+                        TEvent event {};
+                        event.what = evKeyDown;
+                        event.keyDown.keyCode = step.keyCode;
+                        screen->handleEvent(event);
+                        AsyncQueue::getInstance().dispatch();
+                        endFrame(step.text, Clock::now() - start, true);
+                    }
+                    break;
+                case Step::Resize: {
+                    auto start = Clock::now();
+                    setScreenSize(step.size);
+                    screen->changeBounds(TRect(0, 0, step.size.x, step.size.y));
+                    screen->redraw();
+                    endFrame(step.text, Clock::now() - start, true);
+                    break;
+                }
+            }
+        }
+    }
+
+    void report() const {
+        auto s = frameTimes.summarize();
+        char p50[16], p99[16], max[16];
+        std::printf("%-24s %zu (%zu timed)\n", "frames", frames, size_t(s.count));
+        std::printf("%-24s p50 %s, p99 %s, max %s\n", "frame time",
+                    std::string(Profiler::formatDuration(s.p50, p50)).c_str(),
+                    std::string(Profiler::formatDuration(s.p99, p99)).c_str(),
+                    std::string(Profiler::formatDuration(s.max, max)).c_str());
+        std::printf("%-24s %zu total, %.1f per frame, %zu max\n", "bytes to the terminal",
+                    totalBytes, frames ? double(totalBytes) / double(frames) : 0.0, maxBytes);
+
+        // Where the time went, from the probes compiled into the panels.
+        auto& profiler = Profiler::getInstance();
+        for (size_t i = 0; i < size_t(Probe::Count); ++i) {
+            auto p = profiler.summary(Probe(i));
+            if (p.count == 0) continue;
+            std::printf("  %-22s %10zu calls, p50 %s, p99 %s, max %s\n", std::string(Profiler::name(Probe(i))).c_str(),
+                        size_t(p.count), std::string(Profiler::formatDuration(p.p50, p50)).c_str(),
+                        std::string(Profiler::formatDuration(p.p99, p99)).c_str(),
+                        std::string(Profiler::formatDuration(p.max, max)).c_str());
+        }
+    }
+
+private:
+    // TDrawBuffer sizes itself after the screen.
+    static void setScreenSize(TPoint size) {
+        TScreen::screenWidth = ushort(size.x);
+        TScreen::screenHeight = ushort(size.y);
+    }
+
+    // Runs what the event loop would until both panels have loaded and no
+    // background results have come in for a while.
+    void settle() {
+        auto& queue = AsyncQueue::getInstance();
+        auto idleSince = Clock::now();
+        while (Clock::now() - idleSince < SETTLE_TIME) {
+            if (window->leftPanel->isLoading() || window->rightPanel->isLoading() || queue.hasPending()) {
+                queue.dispatch();
+                idleSince = Clock::now();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void endFrame(std::string_view what, Clock::duration elapsed, bool timed) {
+        auto ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        auto cells = screen->cells();
+        size_t bytes = updateBytes(previous, cells, screen->size.x);
+        previous.assign(cells.begin(), cells.end());
+
+        if (timed) frameTimes.record(ns);
+        totalBytes += bytes;
+        maxBytes = std::max(maxBytes, bytes);
+        if (frameLog) {
+            std::fprintf(frameLog, "%zu,\"%.*s\",%llu,%zu\n", frames, int(what.size()), what.data(),
+                         (unsigned long long) ns, bytes);
+        }
+        ++frames;
+    }
+
+    THeadlessScreen* screen;
+    TDoublePanelWindow* window; // Owned by 'screen'.
+    std::FILE* frameLog;
+    std::vector<TScreenCell> previous; // The last frame, as the terminal shows it.
+    LatencyHistogram frameTimes;
+    size_t frames = 0;
+    size_t totalBytes = 0;
+    size_t maxBytes = 0;
+};
+
+void usage() {
+    std::fprintf(stderr, "usage: dn4l_headless [--size COLSxROWS] [--entries N | --dir PATH] [--script FILE] [--frames FILE]\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    TPoint size = DEFAULT_SIZE;
+    size_t entries = DEFAULT_ENTRIES;
+    std::filesystem::path dir;
+    const char* scriptPath = nullptr;
+    const char* framesPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            usage();
+            return 2;
+        }
+        ++i;
+        if (arg == "--size") {
+            if (std::sscanf(value, "%dx%d", &size.x, &size.y) != 2 || size.x <= 0 || size.y <= 0) {
+                usage();
+                return 2;
+            }
+        } else if (arg == "--entries") {
+            entries = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--dir") {
+            dir = value;
+        } else if (arg == "--script") {
+            scriptPath = value;
+        } else if (arg == "--frames") {
+            framesPath = value;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<Step> steps;
+    if (scriptPath) {
+        std::ifstream in(scriptPath);
+        if (!in) {
+            std::fprintf(stderr, "dn4l_headless: cannot open %s\n", scriptPath);
+            return 1;
+        }
+        if (!parseScript(in, steps)) return 1;
+    } else {
+        std::istringstream in {std::string(DEFAULT_SCRIPT)};
+        parseScript(in, steps);
+    }
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> frameLog(nullptr, &std::fclose);
+    if (framesPath) {
+        frameLog.reset(std::fopen(framesPath, "w"));
+        if (!frameLog) {
+            std::fprintf(stderr, "dn4l_headless: cannot write %s\n", framesPath);
+            return 1;
+        }
+        std::fprintf(frameLog.get(), "frame,command,ns,bytes\n");
+    }
+
+    std::unique_ptr<SyntheticTree> tree;
+    if (dir.empty()) {
+        std::printf("Creating %zu entries...\n", entries);
+        tree = std::make_unique<SyntheticTree>(entries);
+        dir = tree->path();
+    }
+
+    Harness harness(size, dir, frameLog.get());
+    Profiler::getInstance().reset(); // Only what the script caused.
+    harness.run(steps);
+    harness.report();
+    return 0;
+}
@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "metafetch.h"
+#include "dirread.h"
+#include "asyncq.h"
+
+#include <algorithm>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// stat() mostly waits on the disk or the network, so there are more workers
+// than cores would suggest.
+constexpr size_t WORKER_COUNT = 8;
+// Entries per job: small enough to spread a screenful over several workers,
+// large enough to keep the number of results posted to the UI thread low.
+constexpr size_t URGENT_JOB_SIZE = 32;
+constexpr size_t BULK_JOB_SIZE = 1024;
+
+}
+
+MetadataFetcher::MetadataFetcher(ResultHandler aOnResult) : onResult(std::move(aOnResult)) {
+}
+
+MetadataFetcher::~MetadataFetcher() {
+    for (auto& w : workers) {
+        w.request_stop();
+    }
+    workers.clear(); // std::jthread joins on destruction.
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void MetadataFetcher::reset(const std::filesystem::path& aDir) {
+    ++generation;
+    dir = aDir;
+    {
+        std::lock_guard lock(mutex);
+        urgentJobs.clear();
+        bulkJobs.clear();
+    }
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void MetadataFetcher::fetch(const FileList& list, const std::vector<size_t>& indexes, bool urgent) {
+    if (indexes.empty()) return;
+
+    size_t jobSize = urgent ? URGENT_JOB_SIZE : BULK_JOB_SIZE;
+    std::vector<Job> jobs;
+    for (size_t begin = 0; begin < indexes.size(); begin += jobSize) {
+        size_t end = std::min(begin + jobSize, indexes.size());
+        Job& job = jobs.emplace_back(Job{dir, generation, {{}, {}, urgent}});
+        job.result.keys.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            const FileEntry& e = list[indexes[i]];
+            job.result.entries.add(list.name(e), e.type);
+            job.result.keys.push_back({e.nameOffset, uint32_t(indexes[i])});
+        }
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        auto& queue = urgent ? urgentJobs : bulkJobs;
+        for (auto& job : jobs) {
+            queue.push_back(std::move(job));
+        }
+    }
+    while (workers.size() < std::min(WORKER_COUNT, jobs.size() + workers.size())) {
+        workers.emplace_back([this](std::stop_token stop) { work(stop); });
+    }
+    wakeUp.notify_all();
+}
+
+void MetadataFetcher::work(std::stop_token stop) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            if (!wakeUp.wait(lock, stop, [this] { return !urgentJobs.empty() || !bulkJobs.empty(); })) {
+                return; // Stop requested.
+            }
+            auto& queue = !urgentJobs.empty() ? urgentJobs : bulkJobs;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        run(job, stop);
+    }
+}
+
+void MetadataFetcher::run(Job& job, std::stop_token stop) {
+    auto stale = [&] { return stop.stop_requested() || generation != job.generation; };
+    FileList& entries = job.result.entries;
+    DirEntryInfo info;
+#ifdef __linux__
+    // Relative lookups spare the kernel from walking the whole path every time.
+    int dirFd = ::open(job.dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    std::string name;
+    for (FileEntry& e : entries) {
+        if (stale()) break;
+        name = entries.name(e); // NUL-terminated, unlike the arena.
+        bool found = dirFd >= 0 ? statDirEntry(dirFd, name.c_str(), info)
+                                : statDirEntry(job.dir / name, info);
+        if (found) copyMetadata(info, e);
+    }
+    if (dirFd >= 0) ::close(dirFd);
+#else
+    for (FileEntry& e : entries) {
+        if (stale()) break;
+        if (statDirEntry(job.dir / entries.name(e), info)) copyMetadata(info, e);
+    }
+#endif
+    if (stale()) return;
+
+    // Only the UI thread may use onResult; the worker merely uses 'this' as a token.
+    AsyncQueue::getInstance().post(this, [this, generation = job.generation, result = std::move(job.result)]() mutable {
+        if (this->generation == generation) onResult(result);
+    });
+}
@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "profview.h"
+#include "dnprof.h"
+
+#include <string_view>
+
+namespace {
+
+constexpr auto REFRESH_INTERVAL = std::chrono::milliseconds(500);
+
+// The probes worth a place on the single line, in order of interest.
+constexpr Probe SHOWN_PROBES[] = {
+    Probe::HandleEvent, Probe::PanelDraw, Probe::DrawLine, Probe::LoadDirectory,
+    Probe::Enumerate, Probe::MergeBatch, Probe::SortList,
+};
+
+}
+
+TProfileView::TProfileView(const TRect& bounds) : TView(bounds) {
+    growMode = gfGrowHiX;
+}
+
+TPalette& TProfileView::getPalette() const {
+    // Looks like the menu bar it is drawn over.
+    static TPalette palette("\x02", 1);
+    return palette;
+}
+
+void TProfileView::draw() {
+    TDrawBuffer b;
+    TColorAttr color = getColor(1);
+    b.moveChar(0, ' ', color, size.x);
+
+    auto& profiler = Profiler::getInstance();
+    int x = 1;
+    for (Probe probe : SHOWN_PROBES) {
+        auto s = profiler.summary(probe);
+        if (s.count == 0) continue;
+        char p50[16], p99[16];
+        std::string_view name = Profiler::name(probe);
+        std::string_view median = Profiler::formatDuration(s.p50, p50);
+        std::string_view tail = Profiler::formatDuration(s.p99, p99);
+        int width = int(name.size() + 1 + median.size() + 1 + tail.size());
+        if (x + width > size.x) break; // Only whole entries.
+        x += b.moveStr(x, name, color);
+        b.moveChar(x++, ' ', color, 1);
+        x += b.moveStr(x, median, color);
+        b.moveChar(x++, '/', color, 1);
+        x += b.moveStr(x, tail, color);
+        x += 2;
+    }
+    writeLine(0, 0, size.x, 1, b);
+    lastDraw = std::chrono::steady_clock::now();
+}
+
+void TProfileView::update() {
+    if ((state & sfVisible) && std::chrono::steady_clock::now() - lastDraw >= REFRESH_INTERVAL) {
+        drawView();
+    }
+}
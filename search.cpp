@@ -0,0 +1,439 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "search.h"
+#include "asyncq.h"
+#include "dirread.h"
+
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t WORKER_COUNT = 8;
+constexpr size_t CHUNK_SIZE = 1 << 20;
+// Files bigger than this are searched as tasks of their own.
+constexpr uint64_t BIG_FILE_SIZE = 4 << 20;
+constexpr auto REPORT_INTERVAL = std::chrono::milliseconds(100);
+// Entries read between checks for a cancellation.
+constexpr size_t CANCEL_CHECK_INTERVAL = 256;
+
+char toLower(char c) {
+    return c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
+}
+
+bool isLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+int64_t now() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+#ifdef __linux__
+// The metadata of an entry itself, not of what a symlink points to.
+bool statEntry(int dirFd, const char* name, FileEntry& e) {
+    struct statx stx;
+    if (::statx(dirFd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, STATX_MODE | STATX_SIZE | STATX_MTIME, &stx) != 0) {
+        return false;
+    }
+    e.hasStat = true;
+    e.mode = stx.stx_mode;
+    e.size = stx.stx_size;
+    e.mtime = stx.stx_mtime.tv_sec;
+    return true;
+}
+#endif
+
+}
+
+ContentMatcher::ContentMatcher(std::string_view aPattern, bool aCaseSensitive)
+    : pattern(aPattern), caseSensitive(aCaseSensitive) {
+    if (!caseSensitive && !pattern.empty()) {
+        for (char& c : pattern) c = toLower(c);
+        firstFold = isLetter(pattern.front()) ? 0x20 : 0;
+        lastFold = isLetter(pattern.back()) ? 0x20 : 0;
+    }
+}
+
+bool ContentMatcher::matchesAt(const char* p) const {
+    if (caseSensitive) return std::memcmp(p, pattern.data(), pattern.size()) == 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (toLower(p[i]) != pattern[i]) return false;
+    }
+    return true;
+}
+
+size_t ContentMatcher::findScalar(const char* data, size_t begin, size_t end) const {
+    if (caseSensitive) {
+        while (begin < end) {
+            auto* p = static_cast<const char*>(std::memchr(data + begin, pattern.front(), end - begin));
+            if (!p) break;
+            if (matchesAt(p)) return size_t(p - data);
+            begin = size_t(p - data) + 1;
+        }
+        return std::string_view::npos;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        if (char(data[i] | firstFold) == pattern.front() && matchesAt(data + i)) return i;
+    }
+    return std::string_view::npos;
+}
+
+size_t ContentMatcher::find(std::string_view data) const {
+    size_t n = pattern.size();
+    if (n == 0) return 0;
+    if (data.size() < n) return std::string_view::npos;
+    const char* p = data.data();
+    size_t end = data.size() - n + 1; // Past the last position the pattern can start at.
+    size_t i = 0;
+#ifdef __SSE2__
+    // A position is a candidate if its byte is the pattern's first one and the
+    // byte n - 1 further on is the last one. The second load ends at most at
+    // the end of the data.
+    const __m128i first = _mm_set1_epi8(pattern.front());
+    const __m128i last = _mm_set1_epi8(pattern.back());
+    const __m128i firstFolds = _mm_set1_epi8(char(firstFold));
+    const __m128i lastFolds = _mm_set1_epi8(char(lastFold));
+    for (; i + 16 <= end; i += 16) {
+        __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), firstFolds);
+        __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + n - 1)), lastFolds);
+        unsigned candidates = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        while (candidates) {
+            size_t offset = i + size_t(std::countr_zero(candidates));
+            if (matchesAt(p + offset)) return offset;
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+    return findScalar(p, i, end);
+}
+
+FileSearcher::Search::Search(Options aOptions, unsigned aGeneration)
+    : options(std::move(aOptions)), generation(aGeneration), mask(options.masks) {
+    if (!options.text.empty()) matcher = std::make_unique<ContentMatcher>(options.text, options.caseSensitive);
+}
+
+FileSearcher::FileSearcher(FoundHandler aOnFound, FinishHandler aOnFinish)
+    : onFound(std::move(aOnFound)), onFinish(std::move(aOnFinish)), queues(WORKER_COUNT) {
+}
+
+FileSearcher::~FileSearcher() {
+    for (auto& w : workers) {
+        w.request_stop();
+    }
+    workers.clear(); // std::jthread joins on destruction.
+    AsyncQueue::getInstance().cancel(this);
+}
+
+void FileSearcher::start(Options options) {
+    cancel();
+    current = std::make_shared<Search>(std::move(options), generation);
+    current->lastReport = now();
+    running = true;
+    if (workers.empty()) {
+        for (size_t w = 0; w < queues.size(); ++w) {
+            workers.emplace_back([this, w](std::stop_token stop) { work(w, stop); });
+        }
+    }
+    current->pending = 1;
+    std::vector<Task> root {{current, {}, true, {}}};
+    queues.push(0, root);
+}
+
+void FileSearcher::cancel() {
+    ++generation;
+    running = false;
+    queues.clear();
+    {
+        std::lock_guard lock(foundMutex);
+        found.clear();
+        reportPosted = false;
+    }
+    AsyncQueue::getInstance().cancel(this);
+}
+
+FileSearcher::Stats FileSearcher::stats() const {
+    if (!current) return {};
+    return {current->directories, current->files, current->searched, current->bytes};
+}
+
+void FileSearcher::work(size_t self, std::stop_token stop) {
+    Task task;
+    std::vector<char> buffer; // Allocated on the first file searched.
+    while (!stop.stop_requested()) {
+        if (!queues.take(self, task)) {
+            if (!queues.wait(stop)) return; // Stop requested.
+            continue;
+        }
+        Search& search = *task.search;
+        if (search.generation == generation) {
+            if (task.directory) {
+                readDirectory(self, task, buffer, stop);
+            } else {
+#ifndef _WIN32
+                ++search.searched;
+                int fd = ::open((search.options.root / task.relative).c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+                if (fd >= 0 && searchFile(search, fd, buffer, stop)) addFound(search, task.relative, task.metadata);
+#endif
+            }
+            report(search, false);
+        }
+        if (--search.pending == 0) finished(task.search);
+        task = {};
+    }
+}
+
+void FileSearcher::readDirectory(size_t self, Task& task, std::vector<char>& buffer, std::stop_token stop) {
+    Search& search = *task.search;
+    auto stale = [&] { return stop.stop_requested() || search.generation != generation; };
+    ++search.directories;
+    std::vector<Task> subtasks;
+    std::string relative;
+    auto relativePath = [&](std::string_view name) -> const std::string& {
+        relative = task.relative;
+        if (!relative.empty()) relative += '/';
+        relative += name;
+        return relative;
+    };
+
+#ifdef __linux__
+    // Entries are looked at without following symlinks, so that no tree is
+    // searched twice and links out of it are left alone.
+    DirectoryReader reader(task.relative.empty() ? search.options.root : search.options.root / task.relative);
+    std::string_view name;
+    bool isDirectory;
+    size_t count = 0;
+    while (reader.nextEntry(name, isDirectory)) {
+        if (++count % CANCEL_CHECK_INTERVAL == 0 && stale()) break;
+        FileEntry metadata {};
+        if (isDirectory) {
+            subtasks.push_back({task.search, relativePath(name), true, {}});
+            // Without text to look for, directories are found by name too.
+            if (!search.matcher && search.mask.matches(name) && statEntry(reader.fd(), name.data(), metadata)) {
+                metadata.type = FileEntryType::Directory;
+                addFound(search, relative, metadata);
+            }
+            continue;
+        }
+        ++search.files;
+        if (!search.mask.matches(name) || !statEntry(reader.fd(), name.data(), metadata)) continue;
+        if (!search.matcher) {
+            addFound(search, relativePath(name), metadata);
+        } else if (S_ISREG(metadata.mode) && metadata.size > 0) {
+            if (metadata.size > BIG_FILE_SIZE) {
+                subtasks.push_back({task.search, relativePath(name), false, metadata});
+                continue;
+            }
+            ++search.searched;
+            int fd = ::openat(reader.fd(), name.data(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+            if (fd >= 0 && searchFile(search, fd, buffer, stop)) addFound(search, relativePath(name), metadata);
+        }
+    }
+#else
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(search.options.root / task.relative, ec), end; !ec && it != end; it.increment(ec)) {
+        if (stale()) break;
+        std::error_code entryEc;
+        auto status = it->symlink_status(entryEc);
+        std::string name = it->path().filename().string();
+        FileEntry metadata {};
+        if (std::filesystem::is_directory(status)) {
+            subtasks.push_back({task.search, relativePath(name), true, {}});
+            if (!search.matcher && search.mask.matches(name)) {
+                metadata.type = FileEntryType::Directory;
+                addFound(search, relative, metadata);
+            }
+            continue;
+        }
+        ++search.files;
+        if (!search.mask.matches(name)) continue;
+        metadata.size = std::filesystem::is_regular_file(status) ? it->file_size(entryEc) : 0;
+        if (!search.matcher) {
+            addFound(search, relativePath(name), metadata);
+        } else if (std::filesystem::is_regular_file(status) && metadata.size > 0) {
+            ++search.searched;
+#ifndef _WIN32
+            int fd = ::open(it->path().c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0 && searchFile(search, fd, buffer, stop)) addFound(search, relativePath(name), metadata);
+#endif
+        }
+    }
+#endif
+    search.pending += subtasks.size();
+    queues.push(self, subtasks);
+}
+
+bool FileSearcher::searchFile(Search& search, int fd, std::vector<char>& buffer, std::stop_token stop) {
+#ifndef _WIN32
+    // Read in big chunks; the last size() - 1 bytes of one are searched again
+    // in front of the next, for a match across the boundary.
+    const ContentMatcher& matcher = *search.matcher;
+    size_t overlap = matcher.size() - 1;
+    buffer.resize(CHUNK_SIZE + overlap);
+#ifdef __linux__
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    bool match = false;
+    size_t carried = 0;
+    while (!match) {
+        ssize_t n = ::read(fd, buffer.data() + carried, CHUNK_SIZE);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        search.bytes += uint64_t(n);
+        size_t size = carried + size_t(n);
+        match = matcher.find({buffer.data(), size}) != std::string_view::npos;
+        carried = std::min(overlap, size);
+        std::memmove(buffer.data(), buffer.data() + size - carried, carried);
+        if (stop.stop_requested() || search.generation != generation) break;
+    }
+    ::close(fd);
+    return match;
+#else
+    (void) search;
+    (void) fd;
+    (void) buffer;
+    (void) stop;
+    return false;
+#endif
+}
+
+void FileSearcher::addFound(Search& search, std::string_view relative, const FileEntry& metadata) {
+    std::lock_guard lock(foundMutex);
+    if (search.generation != generation) return;
+    FileEntry& e = found.add(relative, metadata.type);
+    e.hasStat = metadata.hasStat;
+    e.mode = metadata.mode;
+    e.size = metadata.size;
+    e.mtime = metadata.mtime;
+}
+
+void FileSearcher::report(Search& search, bool force) {
+    int64_t last = search.lastReport;
+    int64_t t = now();
+    if (!force && (t - last < std::chrono::steady_clock::duration(REPORT_INTERVAL).count()
+                   || !search.lastReport.compare_exchange_strong(last, t))) {
+        return;
+    }
+    {
+        // At most one report is on its way; it takes whatever was found until it runs.
+        std::lock_guard lock(foundMutex);
+        if (reportPosted) return;
+        reportPosted = true;
+    }
+    // Only the UI thread may use onFound; the worker merely uses 'this' as a token.
+    AsyncQueue::getInstance().post(this, [this, generation = search.generation] {
+        FileList batch;
+        {
+            std::lock_guard lock(foundMutex);
+            std::swap(batch, found);
+            reportPosted = false;
+        }
+        if (this->generation == generation) onFound(batch);
+    });
+}
+
+void FileSearcher::finished(const std::shared_ptr<Search>& search) {
+    AsyncQueue::getInstance().post(this, [this, search] {
+        if (search->generation != generation) return;
+        FileList batch;
+        {
+            std::lock_guard lock(foundMutex);
+            std::swap(batch, found);
+        }
+        if (!batch.empty()) onFound(batch);
+        running = false;
+        onFinish({search->directories, search->files, search->searched, search->bytes});
+    });
+}
@@ -0,0 +1,213 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "filelist.h"
+#include "filemask.h"
+#include "wsqueue.h"
+
+// Finds a string in blocks of bytes; ASCII letters may match in either case.
+// With SSE2 it checks 16 positions at a time for the pattern's first and last
+// byte and compares the rest only where both are right, which skips most of
+// the data without looking at it twice.
+class ContentMatcher {
+public:
+    ContentMatcher(std::string_view pattern, bool caseSensitive);
+
+    size_t size() const { return pattern.size(); }
+    // The offset of the first occurrence in 'data'; npos if there is none.
+    size_t find(std::string_view data) const;
+
+private:
+    bool matchesAt(const char* p) const;
+    size_t findScalar(const char* data, size_t begin, size_t end) const;
+
+    std::string pattern; // Lowercase unless case sensitive.
+    bool caseSensitive;
+    // OR-ing a byte with these folds the case of the first and last byte of
+    // the pattern if that is a letter; they are 0 otherwise.
+    uint8_t firstFold = 0;
+    uint8_t lastFold = 0;
+};
+
+// Searches a directory tree for files by name and, optionally, content. The
+// tree is walked by a pool of workers (see StealingQueues); big files are
+// searched as tasks of their own, so that idle workers can take them over.
+// What is found is delivered in batches on the UI thread while the search
+// goes on.
+class FileSearcher {
+public:
+    struct Options {
+        std::filesystem::path root;
+        std::string masks;  // See FileMask.
+        std::string text;   // To look for in the files; empty to match by name only.
+        bool caseSensitive = false;
+    };
+
+    struct Stats {
+        uint64_t directories = 0;
+        uint64_t files = 0;   // Whose names were matched.
+        uint64_t searched = 0; // Whose contents were searched.
+        uint64_t bytes = 0;   // Read from those.
+    };
+
+    // 'found' has the paths relative to the root as names, with metadata.
+    // It is empty when there is just new progress to show.
+    using FoundHandler = std::function<void(FileList& found)>;
+    using FinishHandler = std::function<void(const Stats& stats)>;
+
+    // The handlers are invoked on the UI thread (via AsyncQueue).
+    FileSearcher(FoundHandler onFound, FinishHandler onFinish);
+    ~FileSearcher();
+
+    FileSearcher(const FileSearcher&) = delete;
+    FileSearcher& operator=(const FileSearcher&) = delete;
+
+    // Starts a search, cancelling the one running.
+    void start(Options options);
+    void cancel();
+    bool isRunning() const { return running; }
+    // So far.
+    Stats stats() const;
+
+private:
+    // The state of one search, shared by its tasks.
+    struct Search {
+        Search(Options aOptions, unsigned aGeneration);
+
+        Options options;
+        unsigned generation;
+        FileMask mask;
+        std::unique_ptr<ContentMatcher> matcher;
+        std::atomic<size_t> pending {0}; // Tasks queued or running.
+        std::atomic<int64_t> lastReport {0};
+        std::atomic<uint64_t> directories {0};
+        std::atomic<uint64_t> files {0};
+        std::atomic<uint64_t> searched {0};
+        std::atomic<uint64_t> bytes {0};
+    };
+    // A directory to read or a big file to search.
+    struct Task {
+        std::shared_ptr<Search> search;
+        std::string relative; // To the root.
+        bool directory = true;
+        FileEntry metadata {}; // Of a file; name excluded.
+    };
+
+    void work(size_t self, std::stop_token stop);
+    void readDirectory(size_t self, Task& task, std::vector<char>& buffer, std::stop_token stop);
+    // Whether the open file 'fd' contains the text; reads it through 'buffer' and closes it.
+    bool searchFile(Search& search, int fd, std::vector<char>& buffer, std::stop_token stop);
+    void addFound(Search& search, std::string_view relative, const FileEntry& metadata);
+    // Delivers what was found so far, or at least the progress, every now and then.
+    void report(Search& search, bool force);
+    void finished(const std::shared_ptr<Search>& search);
+
+    FoundHandler onFound;
+    FinishHandler onFinish;
+    std::atomic<unsigned> generation {0};
+    bool running = false; // UI thread only.
+    std::shared_ptr<Search> current; // UI thread only.
+
+    std::mutex foundMutex;
+    FileList found;          // Not delivered yet.
+    bool reportPosted = false;
+
+    StealingQueues<Task> queues;
+    std::vector<std::jthread> workers; // Started on the first start().
+};
+
+#endif // SEARCH_H
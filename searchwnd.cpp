@@ -0,0 +1,225 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "searchwnd.h"
+#include "flpanel.h"
+
+#include <algorithm>
+#include <format>
+
+TSearchResults::TSearchResults(const TRect& bounds) : TView(bounds) {
+    growMode = gfGrowHiX | gfGrowHiY;
+    options |= ofSelectable;
+}
+
+void TSearchResults::add(const FileList& found) {
+    bool wasVisible = results.size() < topIndex + pageSize();
+    results.append(found);
+    // Only the rows that were empty change.
+    if (wasVisible) drawView();
+}
+
+void TSearchResults::setStatus(std::string aStatus) {
+    status = std::move(aStatus);
+    drawView();
+}
+
+std::string_view TSearchResults::focusedName() const {
+    if (focusedIndex >= results.size()) return {};
+    return results.name(focusedIndex);
+}
+
+size_t TSearchResults::pageSize() const {
+    return size_t(std::max(size.y - 1, 1)); // The last line is the status.
+}
+
+void TSearchResults::setFocusedIndex(size_t newIndex) {
+    if (results.empty()) return;
+    focusedIndex = std::min(newIndex, results.size() - 1);
+    size_t page = pageSize();
+    if (focusedIndex < topIndex) {
+        topIndex = focusedIndex;
+    } else if (focusedIndex >= topIndex + page) {
+        topIndex = focusedIndex - page + 1;
+    }
+    drawView();
+}
+
+void TSearchResults::draw() {
+    PanelColors colors;
+    colors.normal = colors.selected = getColor(1);
+    colors.focused = colors.focusedSelected = (state & sfFocused) ? getColor(4) : colors.normal;
+    int rows = size.y - 1;
+    PanelLayout layout = PanelLayout::compute(PanelView::Full, 1, {size.x, rows});
+    TDrawBuffer b;
+    for (int y = 0; y < rows; ++y) {
+        TFilePanel::formatLine(b, results, layout, rows, topIndex, y, focusedIndex, colors);
+        writeLine(0, y, size.x, 1, b);
+    }
+    b.moveChar(0, ' ', colors.normal, size.x);
+    b.moveStr(1, status, colors.normal, size.x - 1);
+    writeLine(0, size.y - 1, size.x, 1, b);
+}
+
+void TSearchResults::handleEvent(TEvent& event) {
+    TView::handleEvent(event);
+    if (event.what != evKeyDown) return;
+    switch (event.keyDown.keyCode) {
+        case kbUp:
+            if (focusedIndex > 0) setFocusedIndex(focusedIndex - 1);
+            break;
+        case kbDown:
+            setFocusedIndex(focusedIndex + 1);
+            break;
+        case kbPgUp:
+            setFocusedIndex(focusedIndex - std::min(focusedIndex, pageSize()));
+            break;
+        case kbPgDn:
+            setFocusedIndex(focusedIndex + pageSize());
+            break;
+        case kbHome:
+            setFocusedIndex(0);
+            break;
+        case kbEnd:
+            setFocusedIndex(results.size());
+            break;
+        default:
+            return;
+    }
+    clearEvent(event);
+}
+
+TSearchWindow::TSearchWindow(const TRect& bounds, FileSearcher::Options options, OpenHandler aOnOpen)
+    : TWindowInit(&TSearchWindow::initFrame),
+      TWindow(bounds, std::format("Find: {}", options.masks), wnNoNumber),
+      root(options.root),
+      onOpen(std::move(aOnOpen)),
+      searcher([this](FileList& found) { onFound(found); },
+               [this](const FileSearcher::Stats& stats) { onFinished(stats); }) {
+    TRect r = getExtent();
+    r.grow(-1, -1);
+    results = new TSearchResults(r);
+    insert(results);
+    results->setStatus("Searching...");
+    searcher.start(std::move(options));
+}
+
+void TSearchWindow::onFound(FileList& found) {
+    if (!found.empty()) results->add(found);
+    updateStatus(searcher.stats(), "Searching");
+}
+
+void TSearchWindow::onFinished(const FileSearcher::Stats& stats) {
+    updateStatus(stats, "Done");
+}
+
+void TSearchWindow::updateStatus(const FileSearcher::Stats& stats, std::string_view state) {
+    results->setStatus(std::format("{}: {} found in {} files, {} directories{}", state, results->count(),
+                                   stats.files, stats.directories, searcher.isRunning() ? ". Esc to stop" : ""));
+}
+
+void TSearchWindow::handleEvent(TEvent& event) {
+    TWindow::handleEvent(event);
+    if (event.what != evKeyDown) return;
+    switch (event.keyDown.keyCode) {
+        case kbEnter:
+        {
+            std::string_view name = results->focusedName();
+            if (name.empty()) break;
+            clearEvent(event);
+            onOpen(root / name);
+            close(); // Deletes the window, which cancels the search.
+            return;
+        }
+        case kbEsc:
+            clearEvent(event);
+            if (searcher.isRunning()) {
+                searcher.cancel();
+                updateStatus(searcher.stats(), "Stopped");
+            } else {
+                close();
+            }
+            return;
+        default:
+            break;
+    }
+}
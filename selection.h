@@ -0,0 +1,178 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "filelist.h"
+
+// The selected entries of a FileList, as a bitset parallel to it: a million
+// entries take 128 KiB. The number of entries selected and their total size
+// are kept up to date as bits change, and operations on many entries go a
+// word (64 entries) at a time.
+//
+// Sorting or merging into the list moves entries around; save() and
+// restore() carry the selection over, by the names' offsets in the arena.
+class Selection {
+public:
+    enum class Op : uint8_t { Select, Deselect, Invert };
+
+    bool empty() const { return selectedCount == 0; }
+    size_t count() const { return selectedCount; }
+    // Of the files, and of the directories whose trees have been added up.
+    uint64_t bytes() const { return selectedBytes; }
+    bool test(size_t i) const { return i / 64 < bits.size() && (bits[i / 64] >> (i % 64) & 1); }
+
+    void set(const FileList& list, size_t i, bool value);
+    void clear();
+    // Applies 'op' to the entries of 'list' for which 'pick(i)' is true.
+    template <typename Pick>
+    void apply(const FileList& list, Op op, Pick&& pick);
+    // Calls 'fn(i)' for every selected entry, in list order.
+    template <typename Fn>
+    void forEach(Fn&& fn) const;
+
+    // What an entry adds to bytes().
+    static uint64_t entrySize(const FileEntry& e) {
+        return e.type == FileEntryType::Directory ? (e.hasTreeSize ? e.size : 0) : (e.hasStat ? e.size : 0);
+    }
+    // To be called when entrySize() of entry 'i' changes.
+    void sizeChanged(size_t i, uint64_t oldSize, uint64_t newSize) {
+        if (test(i)) selectedBytes += newSize - oldSize;
+    }
+
+    // Remembers which entries are selected before 'list' is reordered.
+    void save(const FileList& list);
+    // Selects the entries remembered wherever they are now in 'list'; the
+    // ones no longer in it are dropped.
+    void restore(const FileList& list);
+
+private:
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> saved; // By nameOffset, from save() to restore().
+    size_t selectedCount = 0;
+    uint64_t selectedBytes = 0;
+};
+
+template <typename Pick>
+void Selection::apply(const FileList& list, Op op, Pick&& pick) {
+    bits.resize((list.size() + 63) / 64);
+    for (size_t w = 0; w < bits.size(); ++w) {
+        size_t first = w * 64;
+        size_t last = std::min(first + 64, list.size());
+        uint64_t mask = 0;
+        for (size_t i = first; i < last; ++i) {
+            mask |= uint64_t(bool(pick(i))) << (i - first);
+        }
+        uint64_t old = bits[w];
+        uint64_t now = op == Op::Select ? old | mask : op == Op::Deselect ? old & ~mask : old ^ mask;
+        if (now == old) continue;
+        bits[w] = now;
+        selectedCount = selectedCount + std::popcount(now) - std::popcount(old);
+        // Only the entries that changed are looked at again, for their sizes.
+        for (uint64_t changed = now ^ old; changed; changed &= changed - 1) {
+            int bit = std::countr_zero(changed);
+            uint64_t size = entrySize(list[first + bit]);
+            if (now >> bit & 1) {
+                selectedBytes += size;
+            } else {
+                selectedBytes -= size;
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void Selection::forEach(Fn&& fn) const {
+    for (size_t w = 0; w < bits.size(); ++w) {
+        for (uint64_t word = bits[w]; word; word &= word - 1) {
+            fn(w * 64 + std::countr_zero(word));
+        }
+    }
+}
+
+#endif // SELECTION_H
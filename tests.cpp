@@ -0,0 +1,416 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+// dn4l_tests: checks of behaviour that is easy to get subtly wrong and hard
+// to notice from the UI. Each check prints what it found when it fails; the
+// exit status is the number of failed checks, for ctest.
+//
+//   dn4l_tests
+//
+// Files are created in a directory under the system temp directory, removed
+// at the end.
+
+#include "flpanel.h"
+#include "asyncq.h"
+#include "dircache.h"
+#include "dirwatch.h"
+#include "transfer.h"
+#include "viewfile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, std::string_view what) {
+    if (!ok) {
+        std::printf("FAILED: %.*s\n", int(what.size()), what.data());
+        ++failures;
+    }
+}
+
+// A directory of its own in the system temp directory, removed with it.
+class TempDir {
+public:
+    TempDir() {
+        std::string pattern = (std::filesystem::temp_directory_path() / "dn4l_tests.XXXXXX").string();
+        if (::mkdtemp(pattern.data())) root = pattern;
+    }
+    ~TempDir() {
+        std::error_code ec;
+        if (!root.empty()) std::filesystem::remove_all(root, ec);
+    }
+
+    const std::filesystem::path& path() const { return root; }
+
+private:
+    std::filesystem::path root;
+};
+
+void writeFile(const std::filesystem::path& path, size_t size) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(size, 'x');
+}
+
+// Runs what the event loop would until 'done' or a few seconds have passed.
+template <typename F>
+bool dispatchUntil(F&& done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        AsyncQueue::getInstance().dispatch();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    AsyncQueue::getInstance().dispatch();
+    return true;
+}
+
+// The listed entry 'name', or nullptr.
+const FileEntry* findEntry(const FileList& list, std::string_view name) {
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list.name(i) == name) return &list[i];
+    }
+    return nullptr;
+}
+
+// A file rewritten in place keeps its directory's mtime, so its listing comes
+// back from the cache; its size must still be read again.
+void testCachedListingSizes() {
+    TempDir dir;
+    std::filesystem::create_directory(dir.path() / "a");
+    std::filesystem::create_directory(dir.path() / "b");
+    writeFile(dir.path() / "a" / "log", 10);
+
+    DirectoryCache cache;
+    TFilePanel panel(TRect(0, 0, 40, 20), &cache);
+    auto loaded = [&] { return !panel.isLoading(); };
+    auto sized = [&](uint64_t size) {
+        return [&panel, size] {
+            const FileEntry* e = findEntry(panel.getFileList(), "log");
+            return e && e->hasStat && e->size == size;
+        };
+    };
+    // Sorting by size reads the sizes of all the entries.
+    panel.setSortMode(SortMode::Size);
+    panel.showEntry(dir.path() / "a" / "log");
+    check(dispatchUntil(loaded) && dispatchUntil(sized(10)), "cache: the size of a file is read");
+
+    panel.showEntry(dir.path() / "b" / "x");
+    check(dispatchUntil(loaded), "cache: the other directory loads");
+    writeFile(dir.path() / "a" / "log", 1000);
+    size_t hits = cache.stats().hits;
+    panel.showEntry(dir.path() / "a" / "log");
+    check(cache.stats().hits == hits + 1, "cache: going back is a cache hit");
+    check(dispatchUntil(sized(1000)), "cache: a file rewritten in place shows its new size");
+}
+
+// A scan stopped with Esc leaves a partial listing, which must not be cached
+// as the directory's.
+void testCancelledScanNotCached() {
+    TempDir dir;
+    std::filesystem::create_directory(dir.path() / "a");
+    std::filesystem::create_directory(dir.path() / "b");
+    for (int i = 0; i < 50; ++i) writeFile(dir.path() / "a" / ("f" + std::to_string(i)), 1);
+
+    DirectoryCache cache;
+    TFilePanel panel(TRect(0, 0, 40, 20), &cache);
+    panel.setState(sfFocused, True); // Keys only go to the focused panel.
+    panel.loadDirectory(dir.path() / "a");
+    // Nothing the scan found has been merged before the events are dispatched.
+    TEvent event;
+    event.what = evKeyDown;
+    event.keyDown.keyCode = kbEsc;
+    panel.handleEvent(event);
+    check(!panel.isLoading(), "cancel: Esc stops the scan");
+
+    panel.showEntry(dir.path() / "b" / "x");
+    check(dispatchUntil([&] { return !panel.isLoading(); }), "cancel: the other directory loads");
+    panel.showEntry(dir.path() / "a" / "f0");
+    check(dispatchUntil([&] { return !panel.isLoading(); }), "cancel: the directory loads again");
+    check(panel.getFileList().size() == 51, "cancel: the listing is complete when coming back");
+}
+
+// Changes reported while a scan runs wait for it to finish; a scan stopped
+// with Esc still applies them, and sorts the way asked for.
+void testCancelledScanFinishes() {
+    TempDir dir;
+    for (int i = 0; i < 50; ++i) writeFile(dir.path() / ("f" + std::to_string(i)), 1);
+
+    TFilePanel panel(TRect(0, 0, 40, 20));
+    panel.setState(sfFocused, True); // Keys only go to the focused panel.
+    panel.setSortMode(SortMode::Size);
+    panel.loadDirectory(dir.path());
+    writeFile(dir.path() / "a_small", 1);
+    writeFile(dir.path() / "b_big", 100);
+    panel.refreshEntry("a_small");
+    panel.refreshEntry("b_big");
+    TEvent event;
+    event.what = evKeyDown;
+    event.keyDown.keyCode = kbEsc;
+    panel.handleEvent(event);
+
+    const FileList& list = panel.getFileList();
+    const FileEntry* small = findEntry(list, "a_small");
+    const FileEntry* big = findEntry(list, "b_big");
+    check(small && big, "cancel: changes during the scan are applied");
+    check(big < small, "cancel: the listing is sorted by size");
+}
+
+// F3 on a directory adds up the trees of the selected directories, if any.
+void testSizesOfSelection() {
+    TempDir dir;
+    for (const char* name : {"d1", "d2", "d3"}) {
+        std::filesystem::create_directory(dir.path() / name);
+        writeFile(dir.path() / name / "f", 10);
+    }
+    TFilePanel panel(TRect(0, 0, 40, 20));
+    panel.setState(sfFocused, True); // Keys only go to the focused panel.
+    panel.loadDirectory(dir.path());
+    check(dispatchUntil([&] { return !panel.isLoading(); }), "sizes: the directory loads");
+    auto press = [&](ushort key) {
+        TEvent event;
+        event.what = evKeyDown;
+        event.keyDown.keyCode = key;
+        panel.handleEvent(event);
+    };
+    for (const char* name : {"d1", "d3"}) {
+        panel.focusEntry(name);
+        press(kbIns);
+    }
+    panel.focusEntry("d2");
+    press(kbF3);
+
+    const FileList& list = panel.getFileList();
+    auto sized = [&](const char* name) {
+        const FileEntry* e = findEntry(list, name);
+        return e && e->hasTreeSize && e->size == 10;
+    };
+    check(dispatchUntil([&] { return sized("d1") && sized("d3"); }), "sizes: the selected directories are added up");
+    check(!findEntry(list, "d2")->hasTreeSize, "sizes: the focused one isn't");
+}
+
+// The size of what reading 'path' to the end gives, which for files in /proc
+// is not their st_size.
+uint64_t readSize(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    char buffer[1 << 16];
+    uint64_t size = 0;
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) size += uint64_t(in.gcount());
+    return size;
+}
+
+// Copies have the size of their sources, whatever way the data was copied.
+// /proc/kallsyms is copied through the buffer, since it claims to be empty,
+// and is read a page or so at a time.
+void testCopySizes() {
+    TempDir dir;
+    std::filesystem::create_directory(dir.path() / "to");
+    std::vector<std::filesystem::path> sources;
+    for (size_t size : {size_t(0), size_t(1), size_t(4095), size_t(1 << 20), size_t((3 << 20) + 7)}) {
+        sources.push_back(dir.path() / ("f" + std::to_string(size)));
+        writeFile(sources.back(), size);
+    }
+    if (readSize("/proc/kallsyms") > 0) sources.push_back("/proc/kallsyms");
+
+    bool finished = false;
+    TransferEngine engine([](const TransferEngine::Progress&) {},
+                          [&](TransferEngine::Result& result) {
+                              check(result.errorCount == 0, "copy: no errors");
+                              finished = true;
+                          });
+    engine.enqueue(TransferKind::Copy, sources, dir.path() / "to");
+    check(dispatchUntil([&] { return finished; }), "copy: finishes");
+    for (const auto& source : sources) {
+        std::filesystem::path target = dir.path() / "to" / source.filename();
+        check(readSize(target) == readSize(source), "copy: the same size as the source: " + source.string());
+    }
+}
+
+// A file cut short while it is viewed shows what is left of it; the part
+// that is gone is empty rather than a crash.
+void testViewTruncated() {
+    TempDir dir;
+    std::filesystem::path path = dir.path() / "log";
+    std::string line(63, 'x');
+    line += '\n';
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (size_t i = 0; i < (3 << 20) / line.size(); ++i) out << line;
+    }
+    ViewFile file(path, [] {});
+    check(file.error().empty(), "view: opens");
+    check(dispatchUntil([&] { return file.isComplete(); }), "view: counts the lines");
+    check(file.lineCount() == (3 << 20) / line.size(), "view: the number of lines");
+
+    std::filesystem::resize_file(path, 100);
+    std::string scratch;
+    uint64_t next;
+    uint64_t middle = file.lineStart(2 << 20);
+    check(file.line(middle, scratch, next).empty() && next == middle, "view: a line cut off is empty");
+    check(file.line(0, scratch, next) == std::string_view(line).substr(0, 63) && next == 64,
+          "view: a line left is shown");
+}
+
+// Watching another directory drops the old watch, though its worker is only
+// reaped later; nothing it saw is reported.
+void testWatcherRestart() {
+    TempDir dir;
+    std::filesystem::create_directory(dir.path() / "a");
+    std::filesystem::create_directory(dir.path() / "b");
+    std::vector<std::string> seen;
+    auto record = [&](DirectoryChanges& changes) {
+        for (size_t i = 0; i < changes.updated.size(); ++i) seen.emplace_back(changes.updated.name(i));
+    };
+    DirectoryWatcher watcher;
+    for (int i = 0; i < 10; ++i) {
+        check(watcher.start(dir.path() / (i % 2 ? "b" : "a"), record), "watch: starts");
+    }
+    writeFile(dir.path() / "a" / "old", 1);
+    writeFile(dir.path() / "b" / "new", 1);
+    check(dispatchUntil([&] { return !seen.empty(); }), "watch: a change is reported");
+    check(std::find(seen.begin(), seen.end(), "old") == seen.end(), "watch: the old directory isn't reported");
+    watcher.stop();
+    check(!watcher.isActive(), "watch: stops");
+}
+
+// Entries that keep changing leave their old names in the listing's arena,
+// which is compacted before they outweigh the live ones. The selection stays.
+void testArenaCompaction() {
+    TempDir dir;
+    std::vector<std::string> names;
+    for (int i = 0; i < 100; ++i) {
+        names.push_back(std::to_string(1000 + i) + std::string(200, 'n'));
+        writeFile(dir.path() / names.back(), 1);
+    }
+    TFilePanel panel(TRect(0, 0, 40, 20));
+    panel.loadDirectory(dir.path());
+    check(dispatchUntil([&] { return !panel.isLoading(); }), "arena: the directory loads");
+    panel.setState(sfFocused, True); // Keys only go to the focused panel.
+    for (int i : {3, 50, 99}) {
+        panel.focusEntry(names[i]);
+        TEvent event;
+        event.what = evKeyDown;
+        event.keyDown.keyCode = kbIns;
+        panel.handleEvent(event);
+    }
+    std::vector<std::string> selected = panel.selectedNames();
+    check(selected.size() == 3, "arena: three entries are selected");
+
+    const FileList& list = panel.getFileList();
+    size_t live = list.nameBytes() - list.deadNameBytes();
+    size_t most = 0;
+    for (int round = 0; round < 20; ++round) {
+        for (const auto& name : names) panel.refreshEntry(name);
+        most = std::max(most, list.nameBytes());
+    }
+    check(most <= 2 * live + (64 << 10) + 256, "arena: stays bounded: " + std::to_string(most) + " bytes for " + std::to_string(live));
+    check(list.nameBytes() - list.deadNameBytes() == live, "arena: the live names are the same size");
+    size_t found = 0;
+    for (const auto& name : names) found += findEntry(list, name) != nullptr;
+    check(found == names.size(), "arena: every entry is still listed");
+    check(panel.selectedNames() == selected, "arena: the selection stays");
+}
+
+}
+
+int main() {
+    testCachedListingSizes();
+    testCancelledScanNotCached();
+    testCancelledScanFinishes();
+    testSizesOfSelection();
+    testCopySizes();
+    testViewTruncated();
+    testWatcherRestart();
+    testArenaCompaction();
+    if (failures == 0) std::printf("All checks passed.\n");
+    return failures;
+}
@@ -0,0 +1,336 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+// dn4l_tracedump: renders the binary trace written by Logger's binary sink.
+//
+//   dn4l_tracedump [--json] [trace file]
+//
+// Prints one line per message, as text like dn4l.log or as JSON objects, to
+// standard output. The trace file defaults to dn4l.trace.
+
+#include "dntrace.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr const char* LEVEL_NAMES[] = {"debug", "info", "warning", "error"};
+constexpr const char* LEVEL_TAGS[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+
+// Reads fixed-size values from the trace, failing at the end of the data.
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data(data) {}
+
+    bool atEnd() const { return pos == data.size(); }
+
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() - pos < sizeof(T)) return false;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string_view& bytes, size_t length) {
+        if (data.size() - pos < length) return false;
+        bytes = data.substr(pos, length);
+        pos += length;
+        return true;
+    }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+};
+
+struct Argument {
+    std::string text;  // As std::format would show it.
+    std::string json;  // As a JSON value.
+};
+
+std::string jsonString(std::string_view s) {
+    std::string out = "\"";
+    for (unsigned char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += char(c);
+                }
+        }
+    }
+    return out + "\"";
+}
+
+bool readArguments(std::string_view payload, std::vector<Argument>& args) {
+    Reader in(payload);
+    args.clear();
+    char buf[64];
+    while (!in.atEnd()) {
+        TraceArg type;
+        if (!in.read(type)) return false;
+        switch (type) {
+            case TraceArg::Int: {
+                int64_t v;
+                if (!in.read(v)) return false;
+                std::snprintf(buf, sizeof(buf), "%" PRId64, v);
+                args.push_back({buf, buf});
+                break;
+            }
+            case TraceArg::UInt: {
+                uint64_t v;
+                if (!in.read(v)) return false;
+                std::snprintf(buf, sizeof(buf), "%" PRIu64, v);
+                args.push_back({buf, buf});
+                break;
+            }
+            case TraceArg::Double: {
+                double v;
+                if (!in.read(v)) return false;
+                std::snprintf(buf, sizeof(buf), "%g", v);
+                args.push_back({buf, buf});
+                break;
+            }
+            case TraceArg::Bool: {
+                uint8_t v;
+                if (!in.read(v)) return false;
+                args.push_back({v ? "true" : "false", v ? "true" : "false"});
+                break;
+            }
+            case TraceArg::Pointer: {
+                uint64_t v;
+                if (!in.read(v)) return false;
+                std::snprintf(buf, sizeof(buf), "0x%" PRIx64, v);
+                args.push_back({buf, jsonString(buf)});
+                break;
+            }
+            case TraceArg::String: {
+                uint16_t length;
+                std::string_view s;
+                if (!in.read(length) || !in.read(s, length)) return false;
+                args.push_back({std::string(s), jsonString(s)});
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Substitutes the arguments for the {} in 'format'; missing ones show as {?}.
+std::string render(std::string_view format, const std::vector<Argument>& args) {
+    std::string out;
+    size_t next = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            out += c; // Escaped brace.
+            ++i;
+        } else if (c == '{' && i + 1 < format.size() && format[i + 1] == '}') {
+            out += next < args.size() ? args[next].text : "{?}";
+            ++next;
+            ++i;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Formats nanoseconds since the epoch as local time.
+std::string wallTime(int64_t ns) {
+    std::time_t seconds = std::time_t(ns / 1000000000);
+    std::tm tm;
+    char buf[48];
+    if (!localtime_r(&seconds, &tm) || !std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm)) {
+        return "?";
+    }
+    char frac[16];
+    std::snprintf(frac, sizeof(frac), ".%06d", int(ns % 1000000000 / 1000));
+    return std::string(buf) + frac;
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    const char* path = "dn4l.trace";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "dn4l_tracedump: cannot open %s\n", path);
+        return 1;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader in(data);
+    std::unordered_map<uint32_t, std::string> formats;
+    int64_t steadyBase = 0, systemBase = 0;
+    std::vector<Argument> args;
+    auto toWallTime = [&](int64_t steady) { return systemBase + (steady - steadyBase); };
+
+    while (!in.atEnd()) {
+        TraceTag tag;
+        bool ok = in.read(tag);
+        if (ok && tag == TraceTag::Session) {
+            std::string_view magic;
+            ok = in.read(magic, sizeof(TRACE_MAGIC)) && magic == std::string_view(TRACE_MAGIC, sizeof(TRACE_MAGIC))
+                 && in.read(steadyBase) && in.read(systemBase);
+            formats.clear(); // Ids start over with every session.
+        } else if (ok && tag == TraceTag::Format) {
+            uint32_t id;
+            uint16_t length;
+            std::string_view text;
+            ok = in.read(id) && in.read(length) && in.read(text, length);
+            if (ok) formats[id] = text;
+        } else if (ok && tag == TraceTag::Event) {
+            int64_t time;
+            uint8_t level;
+            uint32_t formatId;
+            uint16_t length;
+            std::string_view payload;
+            ok = in.read(time) && in.read(level) && in.read(formatId) && in.read(length) && in.read(payload, length)
+                 && readArguments(payload, args);
+            if (ok) {
+                auto it = formats.find(formatId);
+                std::string_view format = it != formats.end() ? std::string_view(it->second) : "<unknown format>";
+                const char* levelName = level < std::size(LEVEL_NAMES) ? LEVEL_NAMES[level] : "?";
+                std::string text = render(format, args);
+                if (json) {
+                    std::string argList;
+                    for (const auto& a : args) {
+                        argList += (argList.empty() ? "" : ",") + a.json;
+                    }
+                    std::printf("{\"time_ns\":%" PRId64 ",\"time\":%s,\"level\":\"%s\",\"format\":%s,\"args\":[%s],\"text\":%s}\n",
+                                toWallTime(time), jsonString(wallTime(toWallTime(time))).c_str(), levelName,
+                                jsonString(format).c_str(), argList.c_str(), jsonString(text).c_str());
+                } else {
+                    std::printf("%s %s %s\n", wallTime(toWallTime(time)).c_str(),
+                                level < std::size(LEVEL_TAGS) ? LEVEL_TAGS[level] : "?    ", text.c_str());
+                }
+            }
+        } else if (ok && tag == TraceTag::Dropped) {
+            int64_t time;
+            uint64_t count;
+            ok = in.read(time) && in.read(count);
+            if (ok && json) {
+                std::printf("{\"time_ns\":%" PRId64 ",\"time\":%s,\"dropped\":%" PRIu64 "}\n",
+                            toWallTime(time), jsonString(wallTime(toWallTime(time))).c_str(), count);
+            } else if (ok) {
+                std::printf("%s WARN  %" PRIu64 " log messages dropped: the queue was full\n",
+                            wallTime(toWallTime(time)).c_str(), count);
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "dn4l_tracedump: %s is truncated or corrupt\n", path);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,793 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "transfer.h"
+#include "asyncq.h"
+#include "dirread.h"
+#include "dnlogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+
+#include <new>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Copying many small files is dominated by waiting on open() and close(), so
+// there are more workers than cores would suggest.
+constexpr size_t WORKER_COUNT = 8;
+// Files are read and written in chunks this large, so that big ones take few
+// system calls; a small file is copied with one read() and one write().
+constexpr size_t CHUNK_SIZE = 1 << 20;
+constexpr size_t BUFFER_ALIGNMENT = 4096;
+// Per call when the kernel copies; only limits how late cancelling takes effect.
+constexpr size_t KERNEL_CHUNK_SIZE = 16 << 20;
+constexpr auto PROGRESS_INTERVAL = std::chrono::milliseconds(100);
+constexpr size_t MAX_REPORTED_ERRORS = 20;
+
+// True if 'path' is 'dir' or inside it; both must be canonical.
+bool isWithin(const fs::path& path, const fs::path& dir) {
+    auto [d, p] = std::mismatch(dir.begin(), dir.end(), path.begin(), path.end());
+    return d == dir.end();
+}
+
+#ifdef __linux__
+// A directory being deleted; it goes once everything in it has.
+struct DeleteNode {
+    DeleteNode(DeleteNode* aParent, std::string aName) : parent(aParent), name(std::move(aName)) {}
+
+    DeleteNode* parent;
+    std::string name; // In the parent; the whole path at the top.
+    int fd = -1;      // Set while listing; closed when the node is removed.
+    std::atomic<size_t> pending {1}; // Its own listing plus the subdirectories left.
+    std::atomic<bool> incomplete {false}; // Something in it couldn't be deleted.
+};
+
+fs::path pathOf(const DeleteNode* node) {
+    return node->parent ? pathOf(node->parent) / node->name : fs::path(node->name);
+}
+#endif
+
+// Like rename(), but fails with file_exists instead of replacing 'to'.
+std::error_code renameNoReplace(const fs::path& from, const fs::path& to) {
+#ifndef _WIN32
+#ifdef RENAME_NOREPLACE
+    if (::renameat2(AT_FDCWD, from.c_str(), AT_FDCWD, to.c_str(), RENAME_NOREPLACE) == 0) return {};
+    if (errno != EINVAL && errno != ENOSYS) return std::error_code(errno, std::generic_category());
+    // The filesystem doesn't support the flag; check first, racy as that is.
+#endif
+    struct stat st;
+    if (::lstat(to.c_str(), &st) == 0) return std::make_error_code(std::errc::file_exists);
+    if (::rename(from.c_str(), to.c_str()) == 0) return {};
+    return std::error_code(errno, std::generic_category());
+#else
+    std::error_code ec;
+    if (fs::exists(fs::symlink_status(to, ec))) return std::make_error_code(std::errc::file_exists);
+    fs::rename(from, to, ec);
+    return ec;
+#endif
+}
+
+}
+
+const char* copyMethodName(CopyMethod method) {
+    switch (method) {
+        case CopyMethod::Reflink: return "reflink";
+        case CopyMethod::CopyFileRange: return "copy_file_range";
+        case CopyMethod::SendFile: return "sendfile";
+        case CopyMethod::Buffered: return "buffered";
+        case CopyMethod::Count: break;
+    }
+    return "?";
+}
+
+TransferEngine::Buffer::~Buffer() {
+    if (data) ::operator delete[](data, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
+TransferEngine::TransferEngine(ProgressHandler aOnProgress, FinishHandler aOnFinish)
+    : onProgress(std::move(aOnProgress)), onFinish(std::move(aOnFinish)) {
+}
+
+TransferEngine::~TransferEngine() {
+    if (coordinator.joinable()) {
+        coordinator.request_stop(); // Also stops the workers of the running job.
+        coordinator.join();
+    }
+    AsyncQueue::getInstance().cancel(this);
+}
+
+unsigned TransferEngine::enqueue(TransferKind kind, std::vector<fs::path> sources, fs::path destination) {
+    unsigned id = nextJobId++;
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back({id, generation, kind, std::move(sources), std::move(destination)});
+    }
+    ++unfinishedJobs;
+    if (!coordinator.joinable()) {
+        coordinator = std::jthread([this](std::stop_token stop) { work(stop); });
+    }
+    wakeUp.notify_one();
+    return id;
+}
+
+void TransferEngine::cancelAll() {
+    ++generation;
+    std::lock_guard lock(mutex);
+    // The running job reports its end as cancelled; these never start.
+    unfinishedJobs -= jobs.size();
+    jobs.clear();
+}
+
+bool TransferEngine::cancelled(const Job& job, std::stop_token stop) const {
+    return stop.stop_requested() || job.generation != generation;
+}
+
+void TransferEngine::work(std::stop_token stop) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            if (!wakeUp.wait(lock, stop, [this] { return !jobs.empty(); })) {
+                return; // Stop requested.
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        runJob(job, stop);
+    }
+}
+
+void TransferEngine::runJob(const Job& job, std::stop_token stop) {
+    DNLOG_DEBUG("TransferEngine: Starting job", job.id);
+    Run run {job};
+    run.result.job = job.id;
+    run.result.kind = job.kind;
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(job.destination.c_str(), &st) == 0) run.destinationDevice = uint64_t(st.st_dev);
+#endif
+
+    if (job.kind == TransferKind::Delete) {
+        deleteSources(run, stop);
+    } else {
+        std::vector<std::pair<fs::path, fs::path>> directories;
+        postProgress(run, true);
+        plan(run, directories, stop);
+
+        // Parents come first, so every file's directory exists before it is copied.
+        // Existing directories are merged into.
+        for (const auto& [source, target] : directories) {
+            if (cancelled(job, stop)) break;
+            std::error_code ec;
+            if (!fs::create_directory(target, source, ec) && ec) addError(run, target, ec);
+        }
+        if (!cancelled(job, stop)) copyFiles(run, stop);
+        if (job.kind == TransferKind::Move && !cancelled(job, stop)) removeSources(run, directories);
+    }
+
+    run.result.cancelled = cancelled(job, stop);
+    run.result.filesDone = run.filesDone;
+    run.result.bytesDone = run.bytesDone;
+    run.result.renamed = run.renamed;
+    std::string methods;
+    for (size_t m = 0; m < run.result.filesByMethod.size(); ++m) {
+        run.result.filesByMethod[m] = run.filesByMethod[m];
+        if (run.result.filesByMethod[m]) {
+            methods += std::format("{}{} {}", methods.empty() ? "" : ", ", run.result.filesByMethod[m], copyMethodName(CopyMethod(m)));
+        }
+    }
+    DNLOG_INFO("TransferEngine: Job finished (job, files, bytes, renamed, errors, cancelled, methods)",
+        job.id, run.result.filesDone, run.result.bytesDone, run.result.renamed, run.result.errorCount,
+        run.result.cancelled, methods);
+
+    // Only the UI thread may use onFinish; the worker merely uses 'this' as a token.
+    AsyncQueue::getInstance().post(this, [this, result = std::move(run.result)]() mutable {
+        --unfinishedJobs;
+        onFinish(result);
+    });
+}
+
+void TransferEngine::plan(Run& run, std::vector<std::pair<fs::path, fs::path>>& directories, std::stop_token stop) {
+    struct Pending {
+        fs::path dir;
+        fs::path target;
+        bool rename; // The entries are moved by renaming them.
+    };
+    bool move = run.job.kind == TransferKind::Move;
+    auto lastProgress = std::chrono::steady_clock::now();
+    for (const auto& source : run.job.sources) {
+        if (cancelled(run.job, stop)) return;
+        std::error_code ec;
+        fs::path target = run.job.destination / source.filename();
+        fs::path canonicalSource = fs::weakly_canonical(source, ec);
+        if (canonicalSource == fs::weakly_canonical(target, ec)) {
+            addError(run, source, std::make_error_code(std::errc::file_exists));
+            continue;
+        }
+        // Copying or moving a directory into itself would never end.
+        if (isWithin(fs::weakly_canonical(run.job.destination, ec), canonicalSource)) {
+            addError(run, source, std::make_error_code(std::errc::invalid_argument));
+            continue;
+        }
+        RenameResult renamed = move ? moveByRename(run, source, target) : RenameResult::Copy;
+        if (renamed == RenameResult::Done) continue;
+        if (renamed == RenameResult::Copy && planFile(run, source, target)) continue;
+
+        // Depth first, without following symlinks. Every directory is listed
+        // before its contents, so they can be created in this order and
+        // removed in the reverse one.
+        std::vector<Pending> pending {{source, target, renamed == RenameResult::Merge}};
+        std::vector<fs::path> entries;
+        while (!pending.empty()) {
+            if (cancelled(run.job, stop)) return;
+            auto [dir, dirTarget, rename] = std::move(pending.back());
+            pending.pop_back();
+            // Listed in full first when renaming, since that changes the directory.
+            entries.clear();
+            for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+                entries.push_back(it->path());
+            }
+            if (ec) addError(run, dir, ec);
+            for (auto& entry : entries) {
+                fs::path entryTarget = dirTarget / entry.filename();
+                RenameResult result = rename ? moveByRename(run, entry, entryTarget) : RenameResult::Copy;
+                if (result == RenameResult::Merge) {
+                    pending.push_back({std::move(entry), std::move(entryTarget), true});
+                } else if (result == RenameResult::Copy && !planFile(run, entry, entryTarget)) {
+                    pending.push_back({std::move(entry), std::move(entryTarget), false});
+                }
+            }
+            directories.emplace_back(std::move(dir), std::move(dirTarget));
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastProgress >= PROGRESS_INTERVAL) {
+                postProgress(run, true);
+                lastProgress = now;
+            }
+        }
+    }
+
+    // See the class comment for the order.
+    std::stable_sort(run.files.begin(), run.files.end(), [](const FileTask& a, const FileTask& b) { return a.size > b.size; });
+    run.copied.assign(run.files.size(), false);
+}
+
+TransferEngine::RenameResult TransferEngine::moveByRename(Run& run, const fs::path& source, const fs::path& target) {
+    std::error_code ec = renameNoReplace(source, target);
+    if (!ec) {
+        ++run.renamed;
+        ++run.filesDone;
+        return RenameResult::Done;
+    }
+    if (ec == std::errc::cross_device_link) return RenameResult::Copy;
+    if (ec == std::errc::file_exists) {
+        // Directories are merged, the same as when copying; files aren't replaced.
+        std::error_code ec2;
+        if (fs::is_directory(fs::symlink_status(source, ec2)) && fs::is_directory(fs::symlink_status(target, ec2))) {
+            return RenameResult::Merge;
+        }
+    }
+    addError(run, source, ec);
+    return RenameResult::Done;
+}
+
+bool TransferEngine::planFile(Run& run, const fs::path& source, fs::path target) {
+    FileTask task {source, std::move(target), 0, 0, 0, false, false};
+#ifndef _WIN32
+    // One lstat() per entry; copyFile() needs nothing more.
+    struct stat st;
+    if (::lstat(source.c_str(), &st) != 0) {
+        addError(run, source, std::error_code(errno, std::generic_category()));
+        return true;
+    }
+    if (S_ISDIR(st.st_mode)) return false;
+    if (!S_ISREG(st.st_mode) && !S_ISLNK(st.st_mode)) {
+        // Devices, pipes and sockets.
+        addError(run, source, std::make_error_code(std::errc::not_supported));
+        return true;
+    }
+    task.symlink = S_ISLNK(st.st_mode);
+    task.size = task.symlink ? 0 : uint64_t(st.st_size);
+    task.mode = st.st_mode & 07777;
+    task.crossDevice = uint64_t(st.st_dev) != run.destinationDevice;
+#ifdef __APPLE__
+    task.mtimeNs = int64_t(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    task.mtimeNs = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+#else
+    std::error_code ec;
+    fs::file_status status = fs::symlink_status(source, ec);
+    if (ec) {
+        addError(run, source, ec);
+        return true;
+    }
+    if (fs::is_directory(status)) return false;
+    if (!fs::is_regular_file(status) && !fs::is_symlink(status)) {
+        addError(run, source, std::make_error_code(std::errc::not_supported));
+        return true;
+    }
+    task.symlink = fs::is_symlink(status);
+    task.size = task.symlink ? 0 : fs::file_size(source, ec);
+#endif
+    run.bytesTotal += task.size;
+    run.files.push_back(std::move(task));
+    return true;
+}
+
+void TransferEngine::copyFiles(Run& run, std::stop_token stop) {
+    size_t workerCount = std::min(WORKER_COUNT, run.files.size());
+    std::atomic<size_t> running {workerCount};
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    std::vector<std::jthread> workers;
+    for (size_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&] {
+            Buffer buffer; // Allocated on the first file that needs it.
+            for (size_t i; (i = run.nextFile++) < run.files.size() && !cancelled(run.job, stop);) {
+                run.lastStarted = i;
+                std::error_code ec = copyFile(run, run.files[i], buffer, stop);
+                if (ec) {
+                    if (ec != std::errc::operation_canceled) addError(run, run.files[i].source, ec);
+                    continue;
+                }
+                run.copied[i] = true;
+                ++run.filesDone;
+            }
+            if (--running == 0) {
+                std::lock_guard lock(doneMutex);
+                done.notify_all();
+            }
+        });
+    }
+
+    // Report the progress while the workers copy.
+    std::unique_lock lock(doneMutex);
+    while (!done.wait_for(lock, PROGRESS_INTERVAL, [&] { return running == 0; })) {
+        lock.unlock();
+        postProgress(run, false);
+        lock.lock();
+    }
+    lock.unlock();
+    workers.clear(); // Joins them.
+}
+
+std::error_code TransferEngine::copyFile(Run& run, const FileTask& task, Buffer& buffer, std::stop_token stop) {
+    if (cancelled(run.job, stop)) return std::make_error_code(std::errc::operation_canceled);
+#ifndef _WIN32
+    auto lastError = [] { return std::error_code(errno, std::generic_category()); };
+
+    if (task.symlink) {
+        // Copied as a link, like cp -r does.
+        std::error_code ec;
+        fs::path linkTarget = fs::read_symlink(task.source, ec);
+        if (!ec) fs::create_symlink(linkTarget, task.target, ec);
+        return ec;
+    }
+
+    int in = ::open(task.source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return lastError();
+    // Existing files are never overwritten; they are reported as errors. The
+    // permissions are the source's, less the umask, as with cp.
+    int out = ::open(task.target.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode_t(task.mode));
+    if (out < 0) {
+        auto ec = lastError();
+        ::close(in);
+        return ec;
+    }
+
+    std::error_code ec = copyData(run, task, in, out, buffer, stop);
+    if (!ec) {
+        // Like Dos Navigator, keep the modification time.
+        struct timespec times[2] = {{0, UTIME_OMIT}, {time_t(task.mtimeNs / 1000000000), long(task.mtimeNs % 1000000000)}};
+        ::futimens(out, times);
+    }
+    if (::close(out) != 0 && !ec) ec = lastError();
+    ::close(in);
+    if (ec) ::unlink(task.target.c_str()); // No partly copied files.
+    return ec;
+#else
+    (void) buffer;
+    std::error_code ec;
+    fs::copy(task.source, task.target, fs::copy_options::copy_symlinks, ec);
+    if (!ec) fs::last_write_time(task.target, fs::last_write_time(task.source, ec), ec);
+    if (!ec) run.bytesDone += task.size;
+    return ec;
+#endif
+}
+
+#ifndef _WIN32
+std::error_code TransferEngine::copyData(Run& run, const FileTask& task, int in, int out, Buffer& buffer,
+                                         std::stop_token stop) {
+    auto lastError = [] { return std::error_code(errno, std::generic_category()); };
+    auto canceled = [&] { return cancelled(run.job, stop) ? std::make_error_code(std::errc::operation_canceled) : std::error_code(); };
+    auto& unsupported = run.unsupported[task.crossDevice];
+    auto isUnsupported = [&](CopyMethod m) { return unsupported.load(std::memory_order_relaxed) & (1 << int(m)); };
+    auto setUnsupported = [&](CopyMethod m) {
+        if (!isUnsupported(m)) DNLOG_DEBUG("TransferEngine: Not supported here", copyMethodName(m));
+        unsupported.fetch_or(uint8_t(1 << int(m)), std::memory_order_relaxed);
+    };
+    auto used = [&](CopyMethod m) {
+        ++run.filesByMethod[size_t(m)];
+        DNLOG_DEBUG(copyMethodName(m), task.target.string());
+        return std::error_code();
+    };
+    // Errors that mean a method can't be used for this file; anything else is
+    // a failure of the copy itself, e.g. a full disk.
+    auto cantUse = [](int error) {
+        return error == EXDEV || error == ENOSYS || error == EOPNOTSUPP || error == ENOTTY || error == EINVAL;
+    };
+    // The kernel copies up to the size seen when planning; a file still
+    // growing is copied as it was then, which also saves a call to see the end.
+    uint64_t copied = 0;
+
+    // Empty files have nothing to copy, but a read() still tells whether they
+    // really are, which isn't so for those in /proc and the like.
+    if (task.size > 0) {
+#if defined(__linux__) && defined(FICLONE)
+        // Reflinks only work within a filesystem.
+        if (!task.crossDevice && !isUnsupported(CopyMethod::Reflink)) {
+            if (::ioctl(out, FICLONE, in) == 0) {
+                run.bytesDone += task.size;
+                return used(CopyMethod::Reflink);
+            }
+            if (!cantUse(errno)) return lastError();
+            if (errno != EXDEV) setUnsupported(CopyMethod::Reflink);
+        }
+#endif
+#ifdef __linux__
+        if (!isUnsupported(CopyMethod::CopyFileRange)) {
+            while (copied < task.size) {
+                ssize_t n = ::copy_file_range(in, nullptr, out, nullptr, std::min<uint64_t>(task.size - copied, KERNEL_CHUNK_SIZE), 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n < 0 && copied == 0 && cantUse(errno)) {
+                    // Across filesystems, whether it works depends on the kernel
+                    // and the filesystems, but it's the same for every file.
+                    setUnsupported(CopyMethod::CopyFileRange);
+                    break;
+                }
+                if (n < 0) return lastError();
+                if (n == 0) return used(CopyMethod::CopyFileRange); // It shrank.
+                copied += uint64_t(n);
+                run.bytesDone += uint64_t(n);
+                if (auto ec = canceled()) return ec;
+            }
+            if (copied >= task.size) return used(CopyMethod::CopyFileRange);
+        }
+        if (!isUnsupported(CopyMethod::SendFile)) {
+            while (copied < task.size) {
+                ssize_t n = ::sendfile(out, in, nullptr, std::min<uint64_t>(task.size - copied, KERNEL_CHUNK_SIZE));
+                if (n < 0 && errno == EINTR) continue;
+                if (n < 0 && copied == 0 && cantUse(errno)) {
+                    setUnsupported(CopyMethod::SendFile);
+                    break;
+                }
+                if (n < 0) return lastError();
+                if (n == 0) return used(CopyMethod::SendFile);
+                copied += uint64_t(n);
+                run.bytesDone += uint64_t(n);
+                if (auto ec = canceled()) return ec;
+            }
+            if (copied >= task.size) return used(CopyMethod::SendFile);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    if (task.size > CHUNK_SIZE) ::posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    if (!buffer.data) buffer.data = static_cast<char*>(::operator new[](CHUNK_SIZE, std::align_val_t(BUFFER_ALIGNMENT)));
+    while (true) {
+        ssize_t n = ::read(in, buffer.data, CHUNK_SIZE);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return lastError();
+        if (n == 0) break;
+        for (ssize_t written = 0; written < n;) {
+            ssize_t w = ::write(out, buffer.data + written, size_t(n - written));
+            if (w >= 0) {
+                written += w;
+            } else if (errno != EINTR) {
+                return lastError();
+            }
+        }
+        run.bytesDone += uint64_t(n);
+        // Only read() returning 0 is the end: files in /proc and on network
+        // filesystems, and signals, give short reads before it.
+        if (auto ec = canceled()) return ec;
+    }
+    return task.size > 0 ? used(CopyMethod::Buffered) : std::error_code();
+}
+#endif
+
+void TransferEngine::removeSources(Run& run, const std::vector<std::pair<fs::path, fs::path>>& directories) {
+    for (size_t i = 0; i < run.files.size(); ++i) {
+        std::error_code ec;
+        if (run.copied[i] && !fs::remove(run.files[i].source, ec) && ec) addError(run, run.files[i].source, ec);
+    }
+    // Children before their parents. Directories that still hold something
+    // that couldn't be moved stay; that was reported already.
+    for (auto it = directories.rbegin(); it != directories.rend(); ++it) {
+        std::error_code ec;
+        fs::remove(it->first, ec);
+        if (ec && ec != std::errc::directory_not_empty) addError(run, it->first, ec);
+    }
+}
+
+void TransferEngine::deleteSources(Run& run, std::stop_token stop) {
+#ifdef __linux__
+    // Every directory is listed by one worker, which unlinks the files in it
+    // right away, relative to the directory's descriptor. Its subdirectories
+    // are queued for the other workers; a directory is removed by whoever
+    // finishes the last thing in it. Unlinking within one directory doesn't
+    // get faster with more threads, since the kernel serializes it on the
+    // directory, so a directory is the unit of work.
+    std::deque<DeleteNode> nodes; // Stable addresses; guarded by queueMutex.
+    std::vector<DeleteNode*> queue; // To be listed, the latest first, which keeps few directories open.
+    size_t listing = 0;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+
+    // Removes 'node' once everything in it has gone, and then the parents that
+    // became empty by that.
+    auto finish = [&](DeleteNode* node) {
+        while (node && --node->pending == 0) {
+            DeleteNode* parent = node->parent;
+            if (node->fd >= 0) ::close(node->fd);
+            node->fd = -1;
+            if (node->incomplete) {
+                // Whatever is left in it was reported already.
+            } else if (::unlinkat(parent ? parent->fd : AT_FDCWD, node->name.c_str(), AT_REMOVEDIR) == 0) {
+                ++run.filesDone;
+            } else {
+                addError(run, pathOf(node), std::error_code(errno, std::generic_category()));
+                node->incomplete = true;
+            }
+            if (parent && node->incomplete) parent->incomplete = true;
+            node = parent;
+        }
+    };
+
+    auto list = [&](DeleteNode* node) {
+        DirectoryReader reader(node->parent ? node->parent->fd : AT_FDCWD, node->name.c_str());
+        if (reader.error()) {
+            addError(run, pathOf(node), reader.error());
+            node->incomplete = true;
+            finish(node);
+            return;
+        }
+        // Stays open for the subdirectories, which are opened and removed relative to it.
+        node->fd = reader.fd();
+
+        std::vector<std::string> subdirectories;
+        uint64_t found = 0, deleted = 0;
+        std::string_view name;
+        bool isDirectory;
+        while (reader.nextEntry(name, isDirectory)) {
+            ++found;
+            if (isDirectory) {
+                subdirectories.emplace_back(name);
+            } else if (::unlinkat(node->fd, name.data(), 0) == 0 || errno == ENOENT) {
+                ++deleted;
+            } else {
+                addError(run, pathOf(node) / name, std::error_code(errno, std::generic_category()));
+                node->incomplete = true;
+            }
+            // Counted in batches, not to contend on the counters.
+            if (found % 256 == 0) {
+                run.filesFound += found;
+                run.filesDone += deleted;
+                found = deleted = 0;
+                if (cancelled(run.job, stop)) break;
+            }
+        }
+        if (reader.error()) {
+            addError(run, pathOf(node), reader.error());
+            node->incomplete = true;
+        }
+        reader.release();
+        run.filesFound += found;
+        run.filesDone += deleted;
+
+        if (cancelled(run.job, stop)) {
+            node->incomplete = true; // Not an error; it just stays.
+        } else if (!subdirectories.empty()) {
+            node->pending += subdirectories.size();
+            std::lock_guard lock(queueMutex);
+            for (auto& subdirectory : subdirectories) {
+                queue.push_back(&nodes.emplace_back(node, std::move(subdirectory)));
+            }
+            queueChanged.notify_all();
+        }
+        finish(node);
+    };
+
+    for (const auto& source : run.job.sources) {
+        struct stat st;
+        ++run.filesFound;
+        if (::lstat(source.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+            queue.push_back(&nodes.emplace_back(nullptr, source.string()));
+        } else if (::unlink(source.c_str()) == 0) {
+            ++run.filesDone;
+        } else {
+            addError(run, source, std::error_code(errno, std::generic_category()));
+        }
+    }
+
+    size_t workerCount = queue.empty() ? 0 : WORKER_COUNT;
+    std::atomic<size_t> running {workerCount};
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    std::vector<std::jthread> workers;
+    for (size_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&] {
+            std::unique_lock lock(queueMutex);
+            while (true) {
+                // Until there is nothing queued and nobody who could queue more.
+                queueChanged.wait(lock, [&] { return !queue.empty() || listing == 0; });
+                if (queue.empty() || cancelled(run.job, stop)) break;
+                DeleteNode* node = queue.back();
+                queue.pop_back();
+                ++listing;
+                lock.unlock();
+                list(node);
+                lock.lock();
+                --listing;
+            }
+            queueChanged.notify_all(); // The others may be waiting for the end.
+            lock.unlock();
+            if (--running == 0) {
+                std::lock_guard doneLock(doneMutex);
+                done.notify_all();
+            }
+        });
+    }
+
+    // Report the progress while the workers delete.
+    std::unique_lock lock(doneMutex);
+    while (!done.wait_for(lock, PROGRESS_INTERVAL, [&] { return running == 0; })) {
+        lock.unlock();
+        postProgress(run, false);
+        lock.lock();
+    }
+    lock.unlock();
+    workers.clear(); // Joins them.
+
+    // Cancelled: directories still listed or waiting keep their descriptors.
+    for (auto& node : nodes) {
+        if (node.fd >= 0) ::close(node.fd);
+    }
+#else
+    for (const auto& source : run.job.sources) {
+        if (cancelled(run.job, stop)) break;
+        std::error_code ec;
+        auto removed = fs::remove_all(source, ec);
+        if (removed != static_cast<std::uintmax_t>(-1)) run.filesDone += removed;
+        if (ec) addError(run, source, ec);
+    }
+#endif
+}
+
+void TransferEngine::addError(Run& run, const fs::path& path, std::error_code ec) {
+    std::string text = path.string() + ": " + ec.message();
+    DNLOG_WARNING("TransferEngine: Error", text);
+    std::lock_guard lock(run.errorMutex);
+    ++run.result.errorCount;
+    if (run.result.errors.size() < MAX_REPORTED_ERRORS) {
+        run.result.errors.push_back(std::move(text));
+    }
+}
+
+void TransferEngine::postProgress(Run& run, bool scanning) {
+    Progress progress {run.job.id, run.job.kind, scanning, run.filesDone, run.files.size() + run.renamed,
+                       run.bytesDone, run.bytesTotal, 0, {}};
+    {
+        std::lock_guard lock(mutex);
+        progress.jobsQueued = jobs.size();
+    }
+    if (run.job.kind == TransferKind::Delete) {
+        progress.filesTotal = run.filesFound;
+        if (!run.job.sources.empty()) progress.currentName = run.job.sources.front().filename().string();
+    }
+    size_t last = run.lastStarted;
+    if (last < run.files.size()) progress.currentName = run.files[last].source.filename().string();
+
+    AsyncQueue::getInstance().post(this, [this, progress = std::move(progress)] { onProgress(progress); });
+}
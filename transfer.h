@@ -0,0 +1,258 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef TRANSFER_H
+#define TRANSFER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// What a transfer job does with its sources.
+enum class TransferKind : uint8_t {
+    Copy,
+    Move,   // Copy, then remove the sources that were copied.
+    Delete, // Has no destination.
+};
+
+// How the data of a file was copied, the cheapest way available first.
+enum class CopyMethod : uint8_t {
+    Reflink,       // Shares the source's blocks (FICLONE on btrfs, XFS).
+    CopyFileRange, // In the kernel, possibly offloaded to the filesystem.
+    SendFile,      // In the kernel, through the page cache.
+    Buffered,      // Through a user-space buffer.
+    Count
+};
+
+const char* copyMethodName(CopyMethod method);
+
+// Copies and moves files and directory trees in the background. Jobs run one
+// after another in the order they were queued; within a job the files are
+// copied by several workers at once, the largest first, so that a big file
+// doesn't hold up the small ones behind it and many small files keep all the
+// workers busy. Progress and results are delivered on the UI thread via
+// AsyncQueue, so the panels stay usable meanwhile. Moves within a filesystem
+// are renames; only what lives on another filesystem is copied and removed.
+// Deleting walks the trees with several workers too, a directory at a time.
+class TransferEngine {
+public:
+    struct Progress {
+        unsigned job;
+        TransferKind kind;
+        bool scanning;           // Still finding out what there is to do.
+        uint64_t filesDone;
+        uint64_t filesTotal;     // Found so far, when deleting.
+        uint64_t bytesDone;
+        uint64_t bytesTotal;
+        size_t jobsQueued;       // Waiting behind this one.
+        std::string currentName; // The file last started.
+    };
+
+    struct Result {
+        unsigned job;
+        TransferKind kind;
+        bool cancelled;
+        uint64_t filesDone;
+        uint64_t bytesDone;
+        uint64_t renamed; // Entries moved by renaming, whole directories included.
+        std::array<uint64_t, size_t(CopyMethod::Count)> filesByMethod; // Of those with data.
+        size_t errorCount;
+        std::vector<std::string> errors; // "path: message", the first few only.
+    };
+
+    using ProgressHandler = std::function<void(const Progress& progress)>;
+    using FinishHandler = std::function<void(Result& result)>;
+
+    // The handlers are invoked on the UI thread (via AsyncQueue).
+    TransferEngine(ProgressHandler onProgress, FinishHandler onFinish);
+    ~TransferEngine();
+
+    TransferEngine(const TransferEngine&) = delete;
+    TransferEngine& operator=(const TransferEngine&) = delete;
+
+    // Queues copying or moving 'sources' into the directory 'destination'.
+    // Returns the id of the job.
+    unsigned enqueue(TransferKind kind, std::vector<std::filesystem::path> sources, std::filesystem::path destination);
+    // Drops the queued jobs and stops the running one. Files copied so far
+    // stay; a partly copied one is removed.
+    void cancelAll();
+    // True from enqueue() until the last job's FinishHandler has run.
+    bool isBusy() const { return unfinishedJobs > 0; }
+
+private:
+    struct Job {
+        unsigned id;
+        unsigned generation; // Of cancelAll() calls when queued.
+        TransferKind kind;
+        std::vector<std::filesystem::path> sources;
+        std::filesystem::path destination;
+    };
+
+    // A file or symlink to copy, with the metadata read while planning.
+    struct FileTask {
+        std::filesystem::path source;
+        std::filesystem::path target;
+        uint64_t size;
+        uint32_t mode;   // Permission bits.
+        int64_t mtimeNs; // Since the epoch.
+        bool symlink;
+        bool crossDevice; // Not on the destination's filesystem.
+    };
+
+    // A worker's page-aligned buffer for the copies through user space.
+    struct Buffer {
+        Buffer() = default;
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        ~Buffer();
+
+        char* data = nullptr;
+    };
+
+    // The state of the running job, shared by its workers.
+    struct Run {
+        explicit Run(const Job& aJob) : job(aJob) {}
+
+        const Job& job;
+        std::vector<FileTask> files;
+        std::atomic<size_t> nextFile {0};
+        std::atomic<size_t> lastStarted {SIZE_MAX};
+        std::atomic<uint64_t> filesDone {0};
+        std::atomic<uint64_t> bytesDone {0};
+        std::atomic<uint64_t> filesFound {0}; // When deleting.
+        uint64_t renamed = 0;
+        uint64_t bytesTotal = 0;
+        uint64_t destinationDevice = 0;
+        std::array<std::atomic<uint64_t>, size_t(CopyMethod::Count)> filesByMethod {};
+        // Bit per CopyMethod found unsupported, for files on the destination's
+        // filesystem [0] and on others [1]; those aren't tried again.
+        std::atomic<uint8_t> unsupported[2] {};
+        std::vector<char> copied; // By file index; set by the worker that copied it.
+        std::mutex errorMutex;
+        Result result {};
+    };
+
+    void work(std::stop_token stop);
+    void runJob(const Job& job, std::stop_token stop);
+    // Lists what the job has to copy; directories go into 'directories' parents first.
+    void plan(Run& run, std::vector<std::pair<std::filesystem::path, std::filesystem::path>>& directories,
+              std::stop_token stop);
+    // Adds 'source' to the plan if it's a file or symlink; false if it's a directory.
+    bool planFile(Run& run, const std::filesystem::path& source, std::filesystem::path target);
+    enum class RenameResult { Done, Merge, Copy };
+    // Moves 'source' by renaming it, if it and 'target' are on the same filesystem.
+    // Merge means that both are directories and the contents have to be moved.
+    RenameResult moveByRename(Run& run, const std::filesystem::path& source, const std::filesystem::path& target);
+    void copyFiles(Run& run, std::stop_token stop);
+    // Copies one file, reporting the bytes as they are written; 'buffer' is the worker's own.
+    std::error_code copyFile(Run& run, const FileTask& task, Buffer& buffer, std::stop_token stop);
+    // Copies the data from 'in' to 'out' with the first method that works.
+    std::error_code copyData(Run& run, const FileTask& task, int in, int out, Buffer& buffer, std::stop_token stop);
+    void removeSources(Run& run, const std::vector<std::pair<std::filesystem::path, std::filesystem::path>>& directories);
+    void deleteSources(Run& run, std::stop_token stop);
+    bool cancelled(const Job& job, std::stop_token stop) const;
+    void addError(Run& run, const std::filesystem::path& path, std::error_code ec);
+    void postProgress(Run& run, bool scanning);
+
+    ProgressHandler onProgress;
+    FinishHandler onFinish;
+    unsigned nextJobId = 1;
+    size_t unfinishedJobs = 0; // UI thread only.
+    std::atomic<unsigned> generation {0};
+
+    std::mutex mutex;
+    std::condition_variable_any wakeUp;
+    std::deque<Job> jobs;
+    std::jthread coordinator; // Started on the first enqueue().
+};
+
+#endif // TRANSFER_H
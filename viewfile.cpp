@@ -0,0 +1,482 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "viewfile.h"
+#include "asyncq.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr auto REPORT_INTERVAL = std::chrono::milliseconds(100);
+// How long a stream with nothing to read waits before checking for a stop.
+constexpr int POLL_TIMEOUT_MS = 100;
+
+int64_t now() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}
+
+size_t countNewlines(std::string_view data) {
+    const char* p = data.data();
+    size_t n = data.size();
+    size_t i = 0;
+    size_t count = 0;
+#ifdef __SSE2__
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (n - i >= 16) {
+        // A match is -1, so subtracting it counts it in each byte, which
+        // would overflow after 255 steps.
+        size_t steps = std::min<size_t>((n - i) / 16, 255);
+        __m128i counters = _mm_setzero_si128();
+        for (size_t s = 0; s < steps; ++s, i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(v, newline));
+        }
+        __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        count += size_t(_mm_cvtsi128_si32(sums)) + size_t(_mm_extract_epi16(sums, 4));
+    }
+#endif
+    return count + size_t(std::count(p + i, p + n, '\n'));
+}
+
+size_t findNewline(std::string_view data, size_t nth) {
+    const char* p = data.data();
+    size_t n = data.size();
+    size_t i = 0;
+#ifdef __SSE2__
+    // 64 bytes at a time, as a 64-bit mask of their line feeds.
+    const __m128i newline = _mm_set1_epi8('\n');
+    auto matches = [&](size_t at) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + at));
+        return uint64_t(unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline))));
+    };
+    for (; n - i >= 64; i += 64) {
+        uint64_t mask = matches(i) | matches(i + 16) << 16 | matches(i + 32) << 32 | matches(i + 48) << 48;
+        size_t count = size_t(std::popcount(mask));
+        if (count < nth) {
+            nth -= count;
+            continue;
+        }
+        while (--nth) mask &= mask - 1;
+        return i + size_t(std::countr_zero(mask));
+    }
+#endif
+    while (i < n) {
+        auto* q = static_cast<const char*>(std::memchr(p + i, '\n', n - i));
+        if (!q) break;
+        if (--nth == 0) return size_t(q - p);
+        i = size_t(q - p) + 1;
+    }
+    return std::string_view::npos;
+}
+
+ViewFile::ViewFile(const std::filesystem::path& path, ProgressHandler aOnProgress)
+    : onProgress(std::move(aOnProgress)) {
+#ifndef _WIN32
+    // Without O_NONBLOCK, opening a FIFO would wait for a writer.
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        errorText = std::error_code(errno, std::generic_category()).message();
+        return;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        errorText = std::error_code(EISDIR, std::generic_category()).message();
+        return;
+    }
+    // Empty ones are read as a stream, which tells whether they really are.
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        seekable = true;
+        fileSize = uint64_t(st.st_size);
+    }
+    worker = std::jthread([this](std::stop_token stop) {
+        if (seekable) {
+            indexFile(stop);
+        } else {
+            readStream(stop);
+        }
+    });
+#else
+    (void) path;
+    errorText = "Viewing files is not supported on this platform";
+#endif
+}
+
+ViewFile::~ViewFile() {
+    if (worker.joinable()) {
+        worker.request_stop();
+        worker.join();
+    }
+    AsyncQueue::getInstance().cancel(this);
+#ifndef _WIN32
+    if (fd >= 0) ::close(fd);
+#endif
+}
+
+uint64_t ViewFile::streamSize() const {
+    if (blocks.empty()) return firstBlock * BLOCK_SIZE;
+    return (firstBlock + blocks.size() - 1) * BLOCK_SIZE + blocks.back().size();
+}
+
+const std::vector<char>& ViewFile::readBlock(uint64_t b) const {
+    auto it = std::find_if(cache.begin(), cache.end(), [b](const auto& entry) { return entry.first == b; });
+    if (it != cache.end()) {
+        std::rotate(cache.begin(), it, it + 1);
+        return cache.front().second;
+    }
+    if (cache.size() == CACHED_BLOCKS) cache.pop_back();
+    std::vector<char>& block = cache.emplace_front(b, std::vector<char>()).second;
+    uint64_t offset = b * BLOCK_SIZE;
+    block.resize(size_t(std::min<uint64_t>(BLOCK_SIZE, fileSize - std::min(offset, fileSize))));
+#ifndef _WIN32
+    size_t got = 0;
+    while (got < block.size()) {
+        ssize_t n = ::pread(fd, block.data() + got, block.size() - got, off_t(offset + got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break; // Truncated since it was opened, or failing.
+        got += size_t(n);
+    }
+    block.resize(got);
+#endif
+    return block;
+}
+
+uint64_t ViewFile::size() const {
+    if (seekable) return fileSize;
+    std::lock_guard lock(mutex);
+    return streamSize();
+}
+
+uint64_t ViewFile::begin() const {
+    if (seekable) return 0;
+    std::lock_guard lock(mutex);
+    return firstBlock * BLOCK_SIZE;
+}
+
+uint64_t ViewFile::indexed() const {
+    if (complete) return size();
+    std::lock_guard lock(mutex);
+    return (linesBefore.size() - 1) * uint64_t(BLOCK_SIZE);
+}
+
+uint64_t ViewFile::lineCount() const {
+    std::lock_guard lock(mutex);
+    return totalLines;
+}
+
+void ViewFile::setPosition(uint64_t offset) {
+    if (seekable) return;
+    {
+        std::lock_guard lock(mutex);
+        wanted = offset;
+    }
+    moved.notify_all();
+}
+
+template <class Fn>
+bool ViewFile::visit(uint64_t from, uint64_t to, Fn&& fn) const {
+    auto pieces = [&](auto&& blockAt) {
+        for (uint64_t b = from / BLOCK_SIZE; from < to; ++b) {
+            const std::vector<char>* block = blockAt(b);
+            size_t offset = size_t(from - b * BLOCK_SIZE);
+            if (!block || offset >= block->size()) break;
+            size_t length = size_t(std::min<uint64_t>(block->size() - offset, to - from));
+            if (!fn(std::string_view(block->data() + offset, length))) break;
+            from += length;
+        }
+    };
+    if (seekable) {
+        to = std::min(to, fileSize);
+        pieces([this](uint64_t b) { return &readBlock(b); });
+        return true;
+    }
+    std::lock_guard lock(mutex);
+    if (from < firstBlock * BLOCK_SIZE) return false;
+    pieces([this](uint64_t b) { return b - firstBlock < blocks.size() ? &blocks[b - firstBlock] : nullptr; });
+    return true;
+}
+
+std::string_view ViewFile::line(uint64_t offset, std::string& scratch, uint64_t& next) const {
+    scratch.clear();
+    bool ended = false;
+    visit(offset, offset + MAX_LINE, [&](std::string_view piece) {
+        size_t end = piece.find('\n');
+        ended = end != std::string_view::npos;
+        scratch.append(piece.substr(0, end));
+        return !ended;
+    });
+    next = offset + scratch.size() + ended;
+    return scratch;
+}
+
+uint64_t ViewFile::lineStart(uint64_t offset) const {
+    uint64_t first = begin();
+    offset = std::min(offset, size());
+    if (offset <= first) return first;
+    uint64_t from = std::max(first, offset - std::min<uint64_t>(offset, MAX_LINE));
+    uint64_t start = from;
+    uint64_t at = from;
+    visit(from, offset, [&](std::string_view piece) {
+        size_t end = piece.rfind('\n');
+        if (end != std::string_view::npos) start = at + end + 1;
+        at += piece.size();
+        return true;
+    });
+    return start;
+}
+
+uint64_t ViewFile::previousLine(uint64_t offset) const {
+    // Before 'offset' is the line feed that ends the previous line.
+    return offset > begin() ? lineStart(offset - 1) : offset;
+}
+
+std::optional<uint64_t> ViewFile::lineNumber(uint64_t offset) const {
+    uint64_t block = offset / BLOCK_SIZE;
+    uint64_t lines;
+    {
+        std::lock_guard lock(mutex);
+        if (block >= linesBefore.size()) return std::nullopt;
+        lines = linesBefore[block];
+    }
+    bool available = visit(block * BLOCK_SIZE, offset, [&](std::string_view piece) {
+        lines += countNewlines(piece);
+        return true;
+    });
+    if (!available) return std::nullopt;
+    return lines;
+}
+
+std::optional<uint64_t> ViewFile::lineOffset(uint64_t number) const {
+    if (number == 0) return begin() == 0 ? std::optional<uint64_t>(0) : std::nullopt;
+    uint64_t block;
+    size_t nth;
+    {
+        // The line feed ending line number - 1 is in the last block with
+        // fewer lines before it.
+        std::lock_guard lock(mutex);
+        auto it = std::lower_bound(linesBefore.begin(), linesBefore.end(), number);
+        block = uint64_t(it - linesBefore.begin()) - 1;
+        nth = size_t(number - linesBefore[block]);
+    }
+    std::optional<uint64_t> found;
+    uint64_t from = block * BLOCK_SIZE;
+    // A block is a single piece.
+    bool available = visit(from, from + BLOCK_SIZE, [&](std::string_view piece) {
+        size_t end = findNewline(piece, nth);
+        if (end != std::string_view::npos) found = from + end + 1;
+        return false;
+    });
+    if (!available) return std::nullopt;
+    return found;
+}
+
+void ViewFile::indexFile(std::stop_token stop) {
+#ifndef _WIN32
+    // With a buffer of its own, so that the blocks shown stay cached.
+#ifdef __linux__
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    std::vector<char> buffer(BLOCK_SIZE);
+    char last = '\n';
+    for (uint64_t offset = 0; offset < fileSize;) {
+        if (stop.stop_requested()) return;
+        size_t length = size_t(std::min<uint64_t>(BLOCK_SIZE, fileSize - offset));
+        size_t got = 0;
+        while (got < length) {
+            ssize_t n = ::pread(fd, buffer.data() + got, length - got, off_t(offset + got));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break; // Truncated since it was opened, or failing.
+            got += size_t(n);
+        }
+        uint64_t lines = countNewlines({buffer.data(), got});
+        if (got > 0) last = buffer[got - 1];
+        if (got < BLOCK_SIZE) {
+            finish(lines, last != '\n');
+            return;
+        }
+        {
+            std::lock_guard lock(mutex);
+            linesBefore.push_back(linesBefore.back() + lines);
+        }
+        offset += got;
+        reportProgress(false);
+    }
+    if (!stop.stop_requested()) finish(0, last != '\n');
+#else
+    (void) stop;
+#endif
+}
+
+void ViewFile::readStream(std::stop_token stop) {
+#ifndef _WIN32
+    std::vector<char> buffer(64 << 10);
+    uint64_t lines = 0; // In the last block.
+    char last = '\n';
+    while (!stop.stop_requested()) {
+        size_t room;
+        {
+            // Until the viewer gets within half a window of the end.
+            std::unique_lock lock(mutex);
+            bool moving = moved.wait(lock, stop, [&] {
+                uint64_t end = streamSize();
+                return wanted >= end || end - wanted < STREAM_WINDOW / 2;
+            });
+            if (!moving) return;
+            bool full = blocks.empty() || blocks.back().size() == BLOCK_SIZE;
+            room = full ? BLOCK_SIZE : BLOCK_SIZE - blocks.back().size();
+        }
+        ssize_t n = ::read(fd, buffer.data(), std::min(buffer.size(), room));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd pfd {fd, POLLIN, 0};
+            ::poll(&pfd, 1, POLL_TIMEOUT_MS);
+            continue;
+        }
+        if (n <= 0) break;
+        std::string_view piece(buffer.data(), size_t(n));
+        uint64_t pieceLines = countNewlines(piece);
+        last = piece.back();
+        {
+            std::lock_guard lock(mutex);
+            if (blocks.empty() || blocks.back().size() == BLOCK_SIZE) {
+                blocks.emplace_back().reserve(BLOCK_SIZE);
+            }
+            blocks.back().insert(blocks.back().end(), piece.begin(), piece.end());
+            lines += pieceLines;
+            if (blocks.back().size() == BLOCK_SIZE) {
+                linesBefore.push_back(linesBefore.back() + lines);
+                lines = 0;
+            }
+            while (blocks.size() > STREAM_WINDOW / BLOCK_SIZE + 1) {
+                blocks.pop_front();
+                ++firstBlock;
+            }
+        }
+        reportProgress(false);
+    }
+    if (!stop.stop_requested()) finish(lines, last != '\n');
+#else
+    (void) stop;
+#endif
+}
+
+void ViewFile::finish(uint64_t lines, bool unterminated) {
+    {
+        std::lock_guard lock(mutex);
+        totalLines = linesBefore.back() + lines + unterminated;
+    }
+    complete = true;
+    reportProgress(true);
+}
+
+void ViewFile::reportProgress(bool force) {
+    int64_t last = lastReport;
+    int64_t t = now();
+    if (!force && (t - last < std::chrono::steady_clock::duration(REPORT_INTERVAL).count()
+                   || !lastReport.compare_exchange_strong(last, t))) {
+        return;
+    }
+    // At most one report is on its way; it shows the state when it runs.
+    if (reportPosted.exchange(true)) return;
+    AsyncQueue::getInstance().post(this, [this] {
+        reportPosted = false;
+        onProgress();
+    });
+}
@@ -0,0 +1,216 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef VIEWFILE_H
+#define VIEWFILE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Counts the line feeds in 'data'. With SSE2 it compares 16 bytes at a time
+// and adds the matches up in byte counters, which are only summed every 255
+// steps.
+size_t countNewlines(std::string_view data);
+// The position of the nth (from 1) line feed in 'data'; npos if it has fewer.
+size_t findNewline(std::string_view data, size_t nth);
+
+// A file opened for viewing (F3). A regular file is read where it is viewed,
+// a block at a time, so that any part of it can be shown at once; the last
+// CACHED_BLOCKS read are kept. It isn't mapped, since touching a page that
+// was cut off by truncating the file meanwhile would raise SIGBUS. Anything
+// else (a pipe, a device, a file in /proc) is read as a stream, keeping a
+// window of STREAM_WINDOW bytes around the part being viewed.
+//
+// The lines are counted by a background thread. It only keeps the count at
+// every BLOCK_SIZE boundary, so a line's number or offset takes counting at
+// most one block, and the index takes 8 bytes per megabyte of the file.
+class ViewFile {
+public:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+    // Longer lines are shown in pieces of this size.
+    static constexpr size_t MAX_LINE = 16 << 10;
+    // Half of it is read ahead of the position; what is behind it is dropped.
+    static constexpr size_t STREAM_WINDOW = 32 << 20;
+    // A line can span two blocks; the others spare going back and forth.
+    static constexpr size_t CACHED_BLOCKS = 4;
+
+    // Invoked on the UI thread (via AsyncQueue) as the file is read and its
+    // lines counted, every now and then and once done.
+    using ProgressHandler = std::function<void()>;
+
+    ViewFile(const std::filesystem::path& path, ProgressHandler onProgress);
+    ~ViewFile();
+
+    ViewFile(const ViewFile&) = delete;
+    ViewFile& operator=(const ViewFile&) = delete;
+
+    // Why the file could not be opened; empty if it was.
+    const std::string& error() const { return errorText; }
+    bool isStream() const { return !seekable; }
+
+    // The bytes there are so far, and where those still in memory begin
+    // (0 but for a stream).
+    uint64_t size() const;
+    uint64_t begin() const;
+    // Whether the whole file has been read and its lines counted.
+    bool isComplete() const { return complete; }
+    // How many bytes have had their lines counted.
+    uint64_t indexed() const;
+    // Counting the last one even if it has no line feed; once complete.
+    uint64_t lineCount() const;
+
+    // Tells a stream where the viewer is, so that it reads on until the
+    // position is half a window behind its end.
+    void setPosition(uint64_t offset);
+
+    // The line (or piece of one) starting at 'offset', without its line
+    // feed. 'next' gets where the following one starts; it is 'offset' at the
+    // end. The text may be kept in 'scratch'.
+    std::string_view line(uint64_t offset, std::string& scratch, uint64_t& next) const;
+    // Where the line containing 'offset' starts, looking back MAX_LINE bytes
+    // at most.
+    uint64_t lineStart(uint64_t offset) const;
+    // Where the line before the one starting at 'offset' starts.
+    uint64_t previousLine(uint64_t offset) const;
+    // The number (from 0) of the line containing 'offset', once the lines
+    // before it have been counted.
+    std::optional<uint64_t> lineNumber(uint64_t offset) const;
+    // Where line 'number' (from 0) starts, once the lines have been counted
+    // that far.
+    std::optional<uint64_t> lineOffset(uint64_t number) const;
+
+private:
+    // Calls fn(piece) for the bytes of [from, to) there are, in order, while
+    // it returns true. False if those at 'from' are no longer in memory.
+    template <class Fn>
+    bool visit(uint64_t from, uint64_t to, Fn&& fn) const;
+
+    // The end of a stream's window; the mutex is held.
+    uint64_t streamSize() const;
+    // Block 'b' of a regular file, read unless it is cached. Short at the end
+    // of the file, also if that has moved since it was opened.
+    const std::vector<char>& readBlock(uint64_t b) const;
+    void indexFile(std::stop_token stop);
+    void readStream(std::stop_token stop);
+    // 'lines' are those after the last block boundary; 'unterminated' if the
+    // last one has no line feed.
+    void finish(uint64_t lines, bool unterminated);
+    void reportProgress(bool force);
+
+    ProgressHandler onProgress;
+    std::string errorText;
+    int fd = -1;
+    bool seekable = false;
+    uint64_t fileSize = 0; // Of a regular file, when it was opened.
+    // A regular file's blocks last read, the latest first; used by the UI
+    // thread only.
+    mutable std::deque<std::pair<uint64_t, std::vector<char>>> cache;
+
+    mutable std::mutex mutex;
+    // The lines before each block boundary; linesBefore[0] is 0.
+    std::vector<uint64_t> linesBefore {0};
+    uint64_t totalLines = 0;
+    std::atomic<bool> complete {false};
+    // A stream's blocks still in memory, from firstBlock; all but the last are full.
+    std::deque<std::vector<char>> blocks;
+    uint64_t firstBlock = 0;
+    uint64_t wanted = 0; // The viewer's position.
+    std::condition_variable_any moved;
+
+    std::atomic<int64_t> lastReport {0};
+    std::atomic<bool> reportPosted {false};
+    std::jthread worker; // Stopped before the file is closed.
+};
+
+#endif // VIEWFILE_H
@@ -0,0 +1,317 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "viewwnd.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace {
+
+constexpr int TAB_SIZE = 8;
+// How far lines can be scrolled sideways; the longest are MAX_LINE bytes.
+constexpr int MAX_LEFT = int(ViewFile::MAX_LINE);
+
+}
+
+TFileViewer::TFileViewer(const TRect& bounds, const std::filesystem::path& path)
+    : TView(bounds), file(path, [this] { onProgress(); }) {
+    growMode = gfGrowHiX | gfGrowHiY;
+    options |= ofSelectable;
+}
+
+int TFileViewer::pageSize() const {
+    return std::max(size.y - 1, 1); // The last line is the status.
+}
+
+std::string_view TFileViewer::displayed(std::string_view text) {
+    if (text.ends_with('\r')) text.remove_suffix(1);
+    if (text.find('\t') == std::string_view::npos) return text;
+    expanded.clear();
+    for (char c : text) {
+        if (c == '\t') {
+            expanded.append(TAB_SIZE - expanded.size() % TAB_SIZE, ' ');
+        } else {
+            expanded += c;
+        }
+    }
+    return expanded;
+}
+
+void TFileViewer::draw() {
+    TColorAttr color = getColor(1);
+    TDrawBuffer b;
+    uint64_t offset = top;
+    bool ended = false;
+    for (int y = 0; y < pageSize(); ++y) {
+        b.moveChar(0, ' ', color, size.x);
+        if (!ended) {
+            uint64_t next;
+            std::string_view text = file.line(offset, scratch, next);
+            b.moveStr(0, displayed(text), color, size.x, ushort(left));
+            ended = next == offset;
+            offset = next;
+        }
+        writeLine(0, y, size.x, 1, b);
+    }
+
+    uint64_t fileSize = file.size();
+    std::optional<uint64_t> line = file.lineNumber(top);
+    std::string status = line ? std::format("Line {}", *line + 1) : std::string("Line ?");
+    if (file.isComplete()) status += std::format(" of {}", file.lineCount());
+    status += std::format("  Col {}  Offset {}", left + 1, top);
+    if (file.isStream()) {
+        status += std::format("  {} bytes{}", fileSize, file.isComplete() ? "" : " read");
+    } else {
+        status += std::format("  {}%", fileSize ? top * 100 / fileSize : 100);
+        if (!file.isComplete()) status += std::format("  Counting lines: {}%", file.indexed() * 100 / fileSize);
+    }
+    if (pendingLine) status += std::format("  Going to line {}...", *pendingLine + 1);
+    b.moveChar(0, ' ', color, size.x);
+    b.moveStr(1, status, color, size.x - 1);
+    writeLine(0, size.y - 1, size.x, 1, b);
+}
+
+void TFileViewer::moveTo(uint64_t offset) {
+    top = offset;
+    pendingLine.reset();
+    followEnd = false;
+    file.setPosition(top);
+    drawView();
+}
+
+void TFileViewer::scrollDown(int lines) {
+    uint64_t offset = top;
+    for (int i = 0; i < lines; ++i) {
+        uint64_t next;
+        file.line(offset, scratch, next);
+        // The last line stays in view.
+        if (next == offset || next >= file.size()) break;
+        offset = next;
+    }
+    moveTo(offset);
+}
+
+void TFileViewer::scrollUp(int lines) {
+    uint64_t offset = top;
+    for (int i = 0; i < lines; ++i) offset = file.previousLine(offset);
+    moveTo(offset);
+}
+
+void TFileViewer::moveToEnd() {
+    // The last page, which a stream not read to the end keeps following.
+    uint64_t offset = file.size();
+    for (int i = 0; i < pageSize(); ++i) offset = file.previousLine(offset);
+    bool follow = file.isStream() && !file.isComplete();
+    moveTo(offset);
+    if (follow) {
+        followEnd = true;
+        file.setPosition(UINT64_MAX);
+    }
+}
+
+void TFileViewer::goToLine(uint64_t line) {
+    if (file.isComplete() && line >= file.lineCount()) {
+        moveToEnd();
+    } else if (std::optional<uint64_t> offset = file.lineOffset(line)) {
+        moveTo(*offset);
+    } else if (!file.isComplete()) {
+        // Not counted that far yet; see onProgress().
+        pendingLine = line;
+        followEnd = false;
+        file.setPosition(UINT64_MAX);
+        drawView();
+    }
+}
+
+void TFileViewer::goTo() {
+    char text[32] = "";
+    if (inputBox("Go to", "Line, 0x offset or %:", text, sizeof(text) - 1) != cmOK) return;
+    std::string_view input(text);
+    while (input.starts_with(' ')) input.remove_prefix(1);
+    while (input.ends_with(' ')) input.remove_suffix(1);
+    bool hex = input.starts_with("0x") || input.starts_with("0X");
+    bool percent = !hex && input.ends_with('%');
+    if (hex) input.remove_prefix(2);
+    if (percent) input.remove_suffix(1);
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value, hex ? 16 : 10);
+    if (input.empty() || ec != std::errc() || end != input.data() + input.size()) {
+        messageBox(std::format("Not a line, an offset or a percentage: {}", text), mfError | mfOKButton);
+        return;
+    }
+    if (hex) {
+        moveTo(file.lineStart(value));
+    } else if (percent) {
+        moveTo(file.lineStart(file.size() * std::min<uint64_t>(value, 100) / 100));
+    } else {
+        goToLine(value > 0 ? value - 1 : 0);
+    }
+}
+
+void TFileViewer::onProgress() {
+    if (followEnd) {
+        moveToEnd();
+        return;
+    }
+    if (pendingLine) {
+        uint64_t line = *pendingLine;
+        pendingLine.reset();
+        goToLine(line);
+        return;
+    }
+    // A stream drops what is far behind its end.
+    top = std::max(top, file.begin());
+    drawView();
+}
+
+void TFileViewer::handleEvent(TEvent& event) {
+    TView::handleEvent(event);
+    if (event.what != evKeyDown) return;
+    switch (event.keyDown.keyCode) {
+        case kbUp:
+            scrollUp(1);
+            break;
+        case kbDown:
+            scrollDown(1);
+            break;
+        case kbPgUp:
+            scrollUp(pageSize());
+            break;
+        case kbPgDn:
+            scrollDown(pageSize());
+            break;
+        case kbLeft:
+            if (left > 0) {
+                --left;
+                drawView();
+            }
+            break;
+        case kbRight:
+            if (left < MAX_LEFT) {
+                ++left;
+                drawView();
+            }
+            break;
+        case kbHome:
+        case kbCtrlPgUp:
+            left = 0;
+            moveTo(file.begin());
+            break;
+        case kbEnd:
+        case kbCtrlPgDn:
+            left = 0;
+            moveToEnd();
+            break;
+        case kbCtrlG:
+            goTo();
+            break;
+        default:
+            return;
+    }
+    clearEvent(event);
+}
+
+TViewerWindow::TViewerWindow(const TRect& bounds, const std::filesystem::path& path)
+    : TWindowInit(&TViewerWindow::initFrame),
+      TWindow(bounds, path.string(), wnNoNumber) {
+    TRect r = getExtent();
+    r.grow(-1, -1);
+    viewer = new TFileViewer(r, path);
+    insert(viewer);
+}
+
+void TViewerWindow::handleEvent(TEvent& event) {
+    TWindow::handleEvent(event);
+    if (event.what != evKeyDown) return;
+    switch (event.keyDown.keyCode) {
+        case kbEsc:
+        case kbF3:
+        case kbF10:
+            clearEvent(event);
+            close();
+            break;
+        default:
+            break;
+    }
+}
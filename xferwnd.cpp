@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////
+//
+//  dn4l — an LLM-assisted recreation of Dos Navigator in C++.
+//  Copyright (C) 2025 dn3l Contributors.
+//
+//  The development of this code involved significant use of Large
+//  Language Models (LLMs), which were provided with the original
+//  source code of Dos Navigator Version 1.51 as a reference and basis,
+//  so this work should be considered a derivative work of Dos Navigator
+//  and, as such, is governed by the terms of the original Dos Navigator
+//  license, provided below. All terms of the original license
+//  must be adhered to.
+//
+//  All source code files originating from or directly based on Borland's
+//  Turbo Vision library were excluded from the original Dos Navigator
+//  codebase before it was presented to the Large Language Models.
+//  Any Turbo Vision-like functionality within this dn3l project
+//  has been reimplemented or is based on alternative, independently
+//  sourced solutions.
+//
+//  Consequently, direct porting of code from the original Dos Navigator
+//  1.51 source into this dn3l project is permissible, provided that
+//  such ported code segments do not originate from, nor are directly
+//  based on, Borland's Turbo Vision library. Any such directly
+//  ported code will also be governed by the Dos Navigator license terms.
+//
+//  All code within this project, whether LLM-assisted, manually written,
+//  or modified by project contributors, is subject to the terms
+//  of the Dos Navigator license specified below.
+//
+//  Redistributions of source code must retain this notice.
+//
+//  Original Dos Navigator Copyright Notice:
+//
+//////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  Dos Navigator  Version 1.51  Copyright (C) 1991-99 RIT Research Labs
+//
+//  This programs is free for commercial and non-commercial use as long as
+//  the following conditions are aheared to.
+//
+//  Copyright remains RIT Research Labs, and as such any Copyright notices
+//  in the code are not to be removed. If this package is used in a
+//  product, RIT Research Labs should be given attribution as the RIT Research
+//  Labs of the parts of the library used. This can be in the form of a textual
+//  message at program startup or in documentation (online or textual)
+//  provided with the package.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//  1. Redistributions of source code must retain the copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. All advertising materials mentioning features or use of this software
+//     must display the following acknowledgement:
+//     "Based on Dos Navigator by RIT Research Labs."
+//
+//  THIS SOFTWARE IS PROVIDED BY RIT RESEARCH LABS "AS IS" AND ANY EXPRESS
+//  OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+//  GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+//  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The licence and distribution terms for any publically available
+//  version or derivative of this code cannot be changed. i.e. this code
+//  cannot simply be copied and put under another distribution licence
+//  (including the GNU Public Licence).
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "xferwnd.h"
+
+#include <algorithm>
+#include <format>
+#include <string_view>
+
+namespace {
+
+constexpr char BAR_DONE = '\xDB';
+constexpr char BAR_LEFT = '\xB1';
+
+// Writes 'bytes' with a binary unit, e.g. "12.5 MB", into 'buf'.
+std::string_view formatBytes(char (&buf)[16], double bytes) {
+    static constexpr const char* UNITS[] = {"bytes", "KB", "MB", "GB", "TB"};
+    size_t unit = 0;
+    while (bytes >= 1024 && unit + 1 < std::size(UNITS)) {
+        bytes /= 1024;
+        ++unit;
+    }
+    auto end = unit == 0 ? std::format_to_n(buf, sizeof(buf), "{} {}", uint64_t(bytes), UNITS[unit]).out
+                         : std::format_to_n(buf, sizeof(buf), "{:.1f} {}", bytes, UNITS[unit]).out;
+    return {buf, size_t(end - buf)};
+}
+
+}
+
+TTransferWindow::TTransferWindow(const TRect& bounds)
+    : TWindowInit(&TTransferWindow::initFrame), TWindow(bounds, "Copy", wnNoNumber) {
+    // Neither movable nor closable: it goes away by itself when the work is done.
+    flags = 0;
+    options &= ~ofSelectable;
+    palette = wpGrayWindow;
+}
+
+void TTransferWindow::update(const TransferEngine::Progress& aProgress) {
+    if (!hasProgress || aProgress.job != progress.job) {
+        jobStart = std::chrono::steady_clock::now();
+        delete[] (char*) title;
+        title = newStr(aProgress.kind == TransferKind::Move ? "Move"
+                     : aProgress.kind == TransferKind::Delete ? "Delete" : "Copy");
+        frame->drawView();
+    }
+    progress = aProgress;
+    hasProgress = true;
+    drawView();
+}
+
+void TTransferWindow::draw() {
+    TWindow::draw();
+
+    // The window has no interior view to paint the background.
+    TColorAttr color = getColor(6);
+    TDrawBuffer b;
+    b.moveChar(0, ' ', color, size.x - 2);
+    writeLine(1, 1, size.x - 2, size.y - 2, b);
+    if (!hasProgress) return;
+
+    int width = size.x - 4; // Inside the frame, with a margin.
+    auto line = [&](int y, std::string_view text) {
+        b.moveChar(0, ' ', color, size.x - 2);
+        b.moveStr(1, text, color, width);
+        writeLine(1, y, size.x - 2, 1, b);
+    };
+
+    char text[128];
+    bool deleting = progress.kind == TransferKind::Delete;
+    std::string_view verb = progress.kind == TransferKind::Move ? "Moving" : "Copying";
+    // A delete finds the files as it goes, so its total keeps growing.
+    auto end = progress.scanning
+        ? std::format_to_n(text, sizeof(text), "Scanning: {} files so far", progress.filesTotal).out
+        : deleting ? std::format_to_n(text, sizeof(text), "Deleted {} of {} found so far", progress.filesDone, progress.filesTotal).out
+        : std::format_to_n(text, sizeof(text), "{} {} of {} files", verb, progress.filesDone, progress.filesTotal).out;
+    line(1, {text, size_t(end - text)});
+    line(2, progress.currentName);
+
+    // The bar follows the bytes, which is what takes the time.
+    double fraction = progress.bytesTotal ? double(progress.bytesDone) / double(progress.bytesTotal)
+                    : progress.filesTotal ? double(progress.filesDone) / double(progress.filesTotal) : 0;
+    int filled = progress.scanning ? 0 : int(std::clamp(fraction, 0.0, 1.0) * width);
+    b.moveChar(0, ' ', color, size.x - 2);
+    b.moveChar(1, BAR_DONE, color, filled);
+    b.moveChar(1 + filled, BAR_LEFT, color, width - filled);
+    writeLine(1, 3, size.x - 2, 1, b);
+
+    char done[16], total[16], rate[16];
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - jobStart).count();
+    end = deleting ? std::format_to_n(text, sizeof(text), "{:.0f} files/s", seconds > 0 ? double(progress.filesDone) / seconds : 0).out
+        : std::format_to_n(text, sizeof(text), "{} of {}, {}/s", formatBytes(done, double(progress.bytesDone)),
+                           formatBytes(total, double(progress.bytesTotal)),
+                           formatBytes(rate, seconds > 0 ? double(progress.bytesDone) / seconds : 0)).out;
+    line(4, {text, size_t(end - text)});
+
+    end = progress.jobsQueued
+        ? std::format_to_n(text, sizeof(text), "{} more queued. Esc to cancel", progress.jobsQueued).out
+        : std::format_to_n(text, sizeof(text), "Esc to cancel").out;
+    line(5, {text, size_t(end - text)});
+}